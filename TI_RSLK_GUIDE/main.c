@@ -73,33 +73,71 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include "..\inc\Motor.h"
 #include"..\inc\PWM.h"
 #include"..\inc\Reflectance.h"
-
-char* ReplaceSubStr(const char* str, const char* srcSubStr, const char* dstSubStr, char* out)
- {                                                         //this is a string replace function
- const char *p;
- char *_out = out;
- const char *_str = str;
- const char *_src = srcSubStr;
- const char *_dst = dstSubStr;
- int src_size = strlen(_src);
- int dst_size = strlen(_dst);
- int len = 0;
- do
- {
- p = strstr(_str, _src);
- if(p == 0)
- {
- strcpy(_out, _str);
- return out;
- }
- len = p - _str;
- memcpy(_out, _str, len);
- memcpy(_out + len, _dst, dst_size);
- _str = p + src_size;
- _out = _out + len + dst_size;
-} while(p);
-return out;
-}
+#include "..\inc\Nokia5110.h"
+#include "..\inc\StripChart.h"
+#include "..\inc\FlashProgram.h"
+#include "..\inc\FlashStore.h"
+#include "..\inc\Tachometer.h"
+#include "..\inc\Recorder.h"
+#include "..\inc\ADC14.h"
+#include "..\inc\IRDistance.h"
+#include "..\inc\Profile.h"
+#include "..\inc\Timers.h"
+#include "..\inc\Bench.h"
+#include "..\inc\Scheduler.h"
+#include "..\inc\TimerWheel.h"
+#include "..\inc\EUSCIA0.h"
+#include "..\inc\Shell.h"
+#include "..\inc\FSM.h"
+
+// comment this out to run without the LCD strip chart of
+// position and left/right duty while exploring the maze
+#define STRIPCHART 1
+
+// uncomment this to explore and replay a maze of walls with the
+// three IR distance sensors instead of following the black line
+//#define WALLMAZE 1
+#define WALL_OPEN    250  // mm, a side wall farther than this is an opening
+#define WALL_BLOCK   150  // mm, a front wall closer than this blocks the way
+#define WALL_SET     125  // mm, distance kept from a lone side wall
+#define WALL_KP        8  // duty per mm of centring error
+#define WALL_CONFIRM   3  // samples a junction must be seen before acting
+#define WALL_CLEAR   400  // ms straight to leave a junction
+
+// profiling zones, sent with the recording when both buttons are pressed
+#define ZONE_STEP      0  // one exploring step, line_step() or wall_follow()
+#define ZONE_READ      1  // Reflectance_End(), in the one-shot interrupt
+#define ZONE_MOTOR     2  // line_drive()
+
+// line following parameters, tuned over the serial port with the shell between runs
+int32_t Speed = 4000;       // base duty while following and into junctions
+int32_t Kp = 64;            // steering duty per 0.1mm of line position, times 8
+int32_t Ki = 0;             // steering duty per 0.1mm*sample of summed position, times 128
+int32_t Kd = 128;           // steering duty per 0.1mm change in one sample, times 8
+int32_t ApproachMs = 200;   // ms forward into a junction before turning
+int32_t TurnMs = 350;       // ms of a 90 degree turn
+int32_t BackMs = 300;       // ms of a turn around at a dead end
+int32_t MaxRpm = 160;       // replay: top wheel speed on long segments
+int32_t JunctionRpm = 80;   // replay: wheel speed when a junction is reached
+int32_t Accel = 400;        // replay: rpm/s when speeding up and braking
+int32_t Margin = 60;        // replay: steps (0.61 mm) short of the junction to be at JunctionRpm
+int32_t Kv = 16;            // replay: base duty per rpm of speed error each sample, times 16
+int32_t DecayUs = 500;      // us from charging the reflectance sensors to reading them
+const struct ShellParam Params[] = {
+  {"speed",    &Speed,      0, 14998},
+  {"kp",       &Kp,         0, 1000},
+  {"ki",       &Ki,         0, 1000},
+  {"kd",       &Kd,         0, 4000},
+  {"approach", &ApproachMs, 0, 1000},
+  {"turn",     &TurnMs,     0, 1000},
+  {"back",     &BackMs,     0, 1000},
+  {"vmax",     &MaxRpm,     0, 400},
+  {"vjunc",    &JunctionRpm,0, 400},
+  {"accel",    &Accel,      1, 4000},
+  {"margin",   &Margin,     0, 1000},
+  {"kv",       &Kv,         0, 1000},
+  {"decay",    &DecayUs,    100, 900}   // read before line_step(), 1 ms after the charge
+};
 void TimedPause(uint32_t time){
   Clock_Delay1ms(time);          // run for a while and stop
   Motor_Stop();
@@ -112,6 +150,9 @@ void TimedPause(uint32_t time){
 uint8_t Data,ii=0,flag=0;
 int32_t position;
 char path_maze[49];
+uint16_t path_len[49];      // tachometer steps before the junction of each letter, path_len[n] to the end
+int32_t SegStart;          // steps when the last segment began
+int32_t Boundary;          // steps when the last junction was detected
 void ref_left(void){
     Data = Reflectance_Read(500);
     Motor_Forward(4000,4000);
@@ -145,151 +186,385 @@ void ref_turn_around(void){
 
             }
 }
-void reflactance(void){
-
-        Data = Reflectance_Read(500);
-        position = Reflectance_Position(Data);
-
-        if(position==0){
-             Motor_Forward(4000,4000);
-         }
-
-         else if(position>=237){
-                  Motor_Stop();
-                  TimedPause(100);
-                  Motor_Forward(2000,7000);
-                  TimedPause(100);
-                      }
-              //else if((Data == 0x30)||(Data == 0x60)||(Data == 0xC0)){
-              else if(position<=-237){
-                  Motor_Stop();
-                  TimedPause(100);
-                  Motor_Forward(7000,2000);
-                  TimedPause(100);
-              }
-              else if((position>0)&&(position<237)){
-                         Motor_Forward((3000-8*position),3700);
-                     }
-                     //else if((Data == 0x30)||(Data == 0x60)||(Data == 0xC0)){
-              else if((position <0)&&(position>-237)){
-                         Motor_Forward(3700,(3000+8*position));
-                     }
-
-        if(Data == 0xFF){//T·
-                                 Motor_Forward(4000,4000);
-                                          TimedPause(200);
-                                                  Motor_Left(5000,5000);
-                                                  flag=3;
-                                                  TimedPause(350);
-
-        }
-                                                //  else  Motor_Forward(4000,3900);}
-
-                       //else;}
-                        //               else;}
-
-        if((Data == 0xF8)||(Data == 0xF0)||(Data == 0xE0)){//ֱת
-            Data = Reflectance_Read(500);                    //HEY!!!be careful because 0xF8's true meaning
-                        TimedPause(10);      // is reversal F8 11111000 actually 00011111 so right!
-             if((Data == 0xF8)||(Data == 0xF0)||(Data == 0xE0)){
-                 Data = Reflectance_Read(500);
-                             TimedPause(10);
-                if((Data == 0xF8)||(Data == 0xF0)||(Data == 0xE0)){
-              Motor_Forward(4000,3900);
-               TimedPause(200);
-               Data = Reflectance_Read(500);
-               if(Data == 0x00){
-                 Motor_Right(5700,5700);
-                 flag=4;
-                 TimedPause(350);
-                       }
-               else {Motor_Forward(5000,5000);
-                     flag=1;
-                     }
-                       }
-                      // else Motor_Forward(4000,3900);}
-                else;}
-                   else;}
-        else if(Data == 0x00){
-                    Motor_Left(3000,4000);TimedPause(300);
-                    flag=2;
+int32_t line_steps(void){  // distance driven, mean of the two wheels in tachometer steps
+        uint16_t leftTach, rightTach;
+        enum TachDirection leftDir, rightDir;
+        int32_t leftSteps, rightSteps;
+        Tachometer_Get(&leftTach, &leftDir, &leftSteps, &rightTach, &rightDir, &rightSteps);
+        return (leftSteps+rightSteps)/2;
+}
+uint16_t path_segment(void){ // steps from the start of the segment to the last junction
+        int32_t len = Boundary-SegStart;
+        if(len < 0) len = 0;
+        if(len > 0xFFFF) len = 0xFFFF;
+        return len;
+}
+void path_add(char letter){ // add a letter and the length of the segment that led to its junction
+        if(ii >= sizeof(path_maze)-1) return;
+        path_maze[ii] = letter;
+        path_len[ii] = path_segment();
+        SegStart = Boundary;
+        ii++;
+}
+void path_reduce(void){     // take out the dead ends, keeping path_len lined up with the letters
+        const char *substr[6]={"LBR","LBS","RBL","SBL","SBS","LBL"}; //these strings can be replaced by
+        const char keys[6]={'B','R','B','R','B','S'};                //these letters, it's just a wonderful trick
+        uint8_t i,j,k,n,leng;
+        n=strlen(path_maze);
+        do
+        {
+            leng=n;
+            for(i=0;i<6;i++){
+                for(j=0;j+3<=n;j++){
+                    if(strncmp(&path_maze[j],substr[i],3)==0){
+                        path_maze[j]=keys[i];        // the junction keeps the length leading to it,
+                        for(k=j+1;k+2<=n;k++){       // the trip into the dead end and back is dropped
+                            path_maze[k]=path_maze[k+2];
+                            path_len[k]=path_len[k+2];
+                        }
+                        n=n-2;
+                    }
                 }
-
-
-        if((Data == 0x1F)||(Data == 0x0F)||(Data == 0x07)){//ֱת
-            Data = Reflectance_Read(500);
-            TimedPause(5);
-            if((Data == 0x1F)||(Data == 0x0F)||(Data == 0x07)){
-               TimedPause(5);
-                Data = Reflectance_Read(500);
-             if((Data == 0x1F)||(Data == 0x0F)||(Data == 0x07)){
-               Motor_Forward(4000,4000);
-               TimedPause(150);
-               Motor_Left(5000,5000);
-               flag=3;
-               TimedPause(350);
-                       }
-                else;}
-                else;}
-        //else;
-
-
-
-
+            }
+        }while(n<leng);
+}
+char path_letter(void){    // the saved turn for the next junction, 0 once ii has wrapped past the first
+        return (ii < sizeof(path_maze)) ? path_maze[ii] : 0;
+}
+void path_record(uint8_t data, int32_t pos){ // log this step and add the decision in flag to the path
+        Recorder_Log(data, pos, flag);
         switch(flag){               //select the flag then S B L R means qian hou zuo you in chinese
-              case 1:path_maze[ii]='S';ii++;break;
+              case 1:path_add('S');break;
               case 2:
-                     if(path_maze[ii-1]=='B') {}else {path_maze[ii]='B';ii++;}break;//if already has a B then
-              case 3:path_maze[ii]='L';ii++;break;                                  //we won't write a B
-              case 4:path_maze[ii]='R';ii++;break;
+                     if((ii>0)&&(path_maze[ii-1]=='B')) {}else {path_add('B');}break;//if already has a B then
+              case 3:path_add('L');break;                                     //we won't write a B
+              case 4:path_add('R');break;
               default:break;
               }
               flag=0;
+#ifdef STRIPCHART
+              {
+                int16_t left, right;
+                Motor_GetDuty(&left, &right);
+                StripChart_Plot(pos, left, right);
+              }
+#endif
+}
+//line following state machine
+// line_charge() runs on one scheduler tick and starts a one-shot timer
+// that reads the sensors DecayUs later, 500 us like Reflectance_Read(500),
+// and line_step() runs on the next tick with that reading.  The
+// reading is classified, the state machine steps and the motors get
+// the output of the state.  While following, a PID controller on the
+// line position steers around the base Speed at this fixed rate.  Exploring and replaying differ only in
+// the table and in how a junction is classified.
+#define LINE_PERIOD   10  // ms between readings and state machine steps
+enum LineOut{             // motor command of a state
+  OUT_STOP,
+  OUT_FOLLOW,             // PID steering on the line position around Speed
+  OUT_PROFILE,            // replay: PID steering around the duty of the speed loop
+  OUT_FORWARD,            // Speed on both wheels
+  OUT_VEER,               // Speed, right wheel slightly slower, into a right corner
+  OUT_PASS,               // straight over a junction
+  OUT_LEFT,               // exploring turns
+  OUT_RIGHT,
+  OUT_BACK,               // turn around at a dead end
+  OUT_LEFTSLOW,           // replay turns
+  OUT_RIGHTSLOW
+};
+enum LineIn{              // input classes, from line_input() or replay_input()
+  IN_LINE,                // on the line
+  IN_LOST,                // all sensors white
+  IN_TEE,                 // all sensors black
+  IN_LEFT,                // left corner, or replay: take the left branch
+  IN_RIGHT,               // right corner, or replay: take the right branch
+  IN_STRAIGHT,            // replay: go straight over the junction
+  IN_FINISH               // finish marker 0xDB
+};
+// mark on entry: the decision in path_record() codes, 1=S 2=B 3=L 4=R
+enum ExploreState{E_FOLLOW, E_LEFT1, E_LEFT2, E_APPROACHL, E_TURNL,
+  E_RIGHT1, E_RIGHT2, E_APPROACHR, E_TURNR, E_PASS, E_BACK, E_FINISH};
+#define E(s) &Explore[s]
+//   out         mark dwell        LINE          LOST          TEE              LEFT             RIGHT            STRAIGHT      FINISH
+const struct FSMState Explore[] = {
+  {OUT_FOLLOW,   0,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_LEFT1),      E(E_RIGHT1),     E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_FOLLOW,   0,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_LEFT2),      E(E_RIGHT1),     E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_FOLLOW,   0,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_APPROACHL),  E(E_RIGHT1),     E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_FORWARD,  0,   &ApproachMs,{E(E_TURNL),   E(E_TURNL),   E(E_TURNL),      E(E_TURNL),      E(E_TURNL),      E(E_TURNL),   E(E_TURNL)}},
+  {OUT_LEFT,     3,   &TurnMs,    {E(E_FOLLOW),  E(E_FOLLOW),  E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),  E(E_FOLLOW)}},
+  {OUT_FOLLOW,   0,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_LEFT1),      E(E_RIGHT2),     E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_FOLLOW,   0,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_LEFT1),      E(E_APPROACHR),  E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_VEER,     0,   &ApproachMs,{E(E_PASS),    E(E_TURNR),   E(E_PASS),       E(E_PASS),       E(E_PASS),       E(E_PASS),    E(E_PASS)}},
+  {OUT_RIGHT,    4,   &TurnMs,    {E(E_FOLLOW),  E(E_FOLLOW),  E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),  E(E_FOLLOW)}},
+  {OUT_PASS,     1,   0,          {E(E_FOLLOW),  E(E_BACK),    E(E_APPROACHL),  E(E_LEFT1),      E(E_RIGHT1),     E(E_FOLLOW),  E(E_FINISH)}},
+  {OUT_BACK,     2,   &BackMs,    {E(E_FOLLOW),  E(E_FOLLOW),  E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),     E(E_FOLLOW),  E(E_FOLLOW)}},
+  {OUT_STOP,     0,   0,          {E(E_FINISH),  E(E_FINISH),  E(E_FINISH),     E(E_FINISH),     E(E_FINISH),     E(E_FINISH),  E(E_FINISH)}}
+};
+enum ReplayState{R_FOLLOW, R_APPROACHL, R_TURNL, R_APPROACHS, R_PASS, R_APPROACHR, R_TURNR, R_FINISH};
+#define R(s) &Replay[s]
+//   out           mark dwell        LINE          LOST          TEE           LEFT             RIGHT            STRAIGHT         FINISH
+const struct FSMState Replay[] = {
+  {OUT_PROFILE,    0,   0,          {R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),  R(R_APPROACHL),  R(R_APPROACHR),  R(R_APPROACHS),  R(R_FINISH)}},
+  {OUT_FORWARD,    3,   &ApproachMs,{R(R_TURNL),   R(R_TURNL),   R(R_TURNL),   R(R_TURNL),      R(R_TURNL),      R(R_TURNL),      R(R_TURNL)}},
+  {OUT_LEFTSLOW,   0,   &TurnMs,    {R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW)}},
+  {OUT_FORWARD,    1,   &ApproachMs,{R(R_PASS),    R(R_PASS),    R(R_PASS),    R(R_PASS),       R(R_PASS),       R(R_PASS),       R(R_PASS)}},
+  {OUT_FORWARD,    0,   &TurnMs,    {R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW)}},
+  {OUT_FORWARD,    4,   &ApproachMs,{R(R_TURNR),   R(R_TURNR),   R(R_TURNR),   R(R_TURNR),      R(R_TURNR),      R(R_TURNR),      R(R_TURNR)}},
+  {OUT_RIGHTSLOW,  0,   &TurnMs,    {R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),  R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW),     R(R_FOLLOW)}},
+  {OUT_STOP,       0,   0,          {R(R_FINISH),  R(R_FINISH),  R(R_FINISH),  R(R_FINISH),     R(R_FINISH),     R(R_FINISH),     R(R_FINISH)}}
+};
+uint8_t line_input(uint8_t data, int32_t pos){ // classify a reading for the explore table
+    if(data == 0xFF) return IN_TEE;                                          //T junction
+    if((data == 0x1F)||(data == 0x0F)||(data == 0x07)) return IN_LEFT;      //left corner
+    if((data == 0xF8)||(data == 0xF0)||(data == 0xE0)) return IN_RIGHT;     //right corner, bits are reversed
+    if(data == 0x00) return IN_LOST;
+    if(data == 0xDB) return IN_FINISH;                                       //finish marker
+    return IN_LINE;
+}
+uint8_t replay_input(uint8_t data, int32_t pos){ // a junction becomes the saved turn for it
+    uint8_t in = line_input(data, pos);
+    if((in == IN_TEE)||(in == IN_LEFT)||(in == IN_RIGHT)){
+        switch(path_letter()){
+            case 'L': return IN_LEFT;
+            case 'R': return IN_RIGHT;
+            default:  return IN_STRAIGHT;
+        }
+    }
+    return in;
+}
+#define LINE_MAXDUTY 14998    // largest Motor_Forward() duty
+#define LINE_IMAX    20000    // limit of the summed position, 0.1mm*samples
+int32_t LastPosition;         // position one LINE_PERIOD ago, for the derivative
+int32_t Integral;             // summed position, only while not saturated
+void line_pid(int32_t base){  // a positive position slows the left wheel
+    int32_t u, left, right;
+    u = (Kp*position + Kd*(position-LastPosition))/8 + Ki*Integral/128;
+    LastPosition = position;
+    left = base - u;
+    right = base + u;
+    if(right > LINE_MAXDUTY){ // keep the steering difference, give up base speed
+        left = left - (right-LINE_MAXDUTY);
+        right = LINE_MAXDUTY;
+    }
+    if(left > LINE_MAXDUTY){
+        right = right - (left-LINE_MAXDUTY);
+        left = LINE_MAXDUTY;
+    }
+    if((left < 0)||(right < 0)){ // wheels do not reverse here, so stop integrating
+        if(left < 0) left = 0;
+        if(right < 0) right = 0;
+    }else{
+        Integral = Integral + position;
+        if(Integral > LINE_IMAX) Integral = LINE_IMAX;
+        if(Integral < -LINE_IMAX) Integral = -LINE_IMAX;
+    }
+    Motor_Forward(left,right);
+}
+uint16_t SegLength;           // replay: steps of the segment being driven, 0 if not known
+int32_t ReplayDuty;           // replay: base duty from the speed loop
+uint32_t isqrt(uint32_t n){   // largest r with r*r <= n
+    uint32_t r = 0, bit = 1UL<<30;
+    while(bit > n) bit = bit>>2;
+    while(bit){
+        if(n >= r+bit){
+            n = n-(r+bit);
+            r = (r>>1)+bit;
+        }else{
+            r = r>>1;
+        }
+        bit = bit>>2;
+    }
+    return r;
+}
+int32_t line_profile(void){   // replay: trapezoid over distance, speed up from the last junction, brake for the next
+    int32_t done, left, vj, a, v;
+    if(SegLength == 0) return JunctionRpm; // length not known, stay slow
+    vj = 6*JunctionRpm;                    // steps/s, 360 steps per turn
+    a = 6*Accel;                           // steps/s/s
+    done = line_steps()-SegStart;
+    left = SegLength-Margin-done;
+    if(left < done) done = left;           // braking limits the speed more than speeding up
+    if(done < 0) done = 0;
+    if(done > 40000) done = 40000;         // v*v stays in 32 bits
+    v = isqrt(vj*vj + 2*a*done)/6;         // v*v = vj*vj + 2*a*distance
+    if(v > MaxRpm) v = MaxRpm;
+    return v;
+}
+int32_t line_speed(int32_t rpm){ // replay: integral control of the mean wheel speed, returns the base duty
+    uint32_t leftRpm, rightRpm;
+    Tachometer_GetRpm(&leftRpm, &rightRpm);
+    ReplayDuty = ReplayDuty + Kv*(rpm-(int32_t)(leftRpm+rightRpm)/2)/16;
+    if(ReplayDuty > LINE_MAXDUTY) ReplayDuty = LINE_MAXDUTY;
+    if(ReplayDuty < 0) ReplayDuty = 0;
+    return ReplayDuty;
+}
+uint8_t line_following(uint8_t out){
+    return (out == OUT_FOLLOW)||(out == OUT_PROFILE);
+}
+void line_drive(uint8_t out){
+    switch(out){
+        case OUT_FOLLOW:    line_pid(Speed); break;
+        case OUT_PROFILE:   line_pid(line_speed(line_profile())); break;
+        case OUT_FORWARD:   Motor_Forward(Speed,Speed); break;
+        case OUT_VEER:      Motor_Forward(Speed,Speed-100); break;
+        case OUT_PASS:      Motor_Forward(5000,5000); break;
+        case OUT_LEFT:      Motor_Left(5000,5000); break;
+        case OUT_RIGHT:     Motor_Right(5700,5700); break;
+        case OUT_BACK:      Motor_Left(3000,4000); break;
+        case OUT_LEFTSLOW:  Motor_Left(4000,4000); break;
+        case OUT_RIGHTSLOW: Motor_Right(4000,4000); break;
+        default:            Motor_Stop(); break;
+    }
+}
+uint8_t (*LineInput)(uint8_t data, int32_t pos); // line_input or replay_input
+uint8_t Replaying;         // 1 if marks use up path letters, 0 if they add to the path
+uint8_t Finished;          // 1 once the finish marker has stopped the robot
+int LineStart=-1,LineStep=-1; // scheduler tasks
+int LineTimer=-1;          // one-shot timer that reads the sensors
+void line_sample(void){    // DecayUs after line_charge(), in the one-shot interrupt
+        PROFILE_BEGIN(ZONE_READ);
+        Data = Reflectance_End();
+        PROFILE_END(ZONE_READ);
+}
+void line_charge(void){
+        Reflectance_Start();
+        Timers_OneShot(LineTimer, DecayUs, 2);
+}
+void line_step(void){      // runs 1 ms after line_charge()
+        uint8_t last = FSM_State()->out;
+        PROFILE_BEGIN(ZONE_STEP);
+        if(LineTimer < 0) line_sample(); // no timer was free, read 1 ms after the charge
+        if(Data){                 // off the line, keep steering on the last position
+            position = Reflectance_Position(Data);
+        }
+        if(FSM_Step((*LineInput)(Data, position))){
+            LastPosition = position;             // no derivative kick or old integral after a turn
+            Integral = 0;
+            if(FSM_State()->out == OUT_STOP) Finished = 1; // on the finish marker
+            if(FSM_State()->mark){
+                if(Replaying) ii--;              // this junction's turn is taken
+                else flag = FSM_State()->mark;   // recorded by path_record()
+            }
+            if(line_following(last) && !line_following(FSM_State()->out)){
+                Boundary = line_steps();         // a junction or dead end was found
+                if(Replaying){                   // the next segment starts here, ii wraps to 255 after the last turn
+                    SegStart = Boundary;
+                    SegLength = path_len[(uint8_t)(ii+1)];
+                }
+            }
+        }
+        PROFILE_BEGIN(ZONE_MOTOR);
+        line_drive(FSM_State()->out);
+        PROFILE_END(ZONE_MOTOR);
+        if(Replaying) Recorder_Log(Data, position, path_letter());
+        else path_record(Data, position);
+        PROFILE_END(ZONE_STEP);
+}
+void line_run(const struct FSMState *table, uint8_t (*input)(uint8_t, int32_t), uint8_t replay){
+        LineInput = input;
+        Replaying = replay;
+        Finished = 0;
+        FSM_Init(table, LINE_PERIOD);
+        LastPosition = position;
+        Integral = 0;
+        SegStart = Boundary = line_steps();
+        SegLength = replay ? path_len[(uint8_t)(ii+1)] : 0;
+        ReplayDuty = Speed;
+        line_drive(table->out);
+        LineTimer = Timers_Request(TIMERS_ANY, TIMERS_ONESHOT, &line_sample, 0);
+        LineStart = Scheduler_AddTask(&line_charge, LINE_PERIOD, 0, 0);
+        LineStep = Scheduler_AddTask(&line_step, LINE_PERIOD, 1, 0);
+}
+void line_stop(void){
+        Scheduler_RemoveTask(LineStart);
+        Scheduler_RemoveTask(LineStep);
+        Timers_Release(LineTimer);
+        LineTimer = -1;
+        Motor_Stop();
 }
-void RFL_2(void){                           //MOD 2 read the directions that we wrote and optimize in the
-                                            //path_maze array and then take the action
-        Data = Reflectance_Read(500);
-        position = Reflectance_Position(Data);
-        if(position==0){
-             Motor_Forward(4000,4000);
-         }
 
-         else if(position>=237){
-                  Motor_Stop();
-                  TimedPause(100);
-                  Motor_Forward(2000,7000);
-                  TimedPause(100);
-                      }
-              //else if((Data == 0x30)||(Data == 0x60)||(Data == 0xC0)){
-              else if(position<=-237){
-                  Motor_Stop();
-                  TimedPause(100);
-                  Motor_Forward(7000,2000);
-                  TimedPause(100);
-              }
-              else if((position>0)&&(position<237)){
-                         Motor_Forward((3000-8*position),3700);
-                     }
-                     //else if((Data == 0x30)||(Data == 0x60)||(Data == 0xC0)){
-              else if((position <0)&&(position>-237)){
-                         Motor_Forward(3700,(3000+8*position));
-                     }
-        Data = Reflectance_Read(500);
-    if((Data == 0x1F)||(Data == 0x0F)||(Data == 0x07)||(Data == 0xF8)||(Data == 0xF0)||(Data == 0xE0)||(Data==0xFF))
-       {
-           switch(path_maze[ii]){
+
+//walls
+uint8_t walls,seen=0;      // walls bit2=left, bit1=front, bit0=right; seen counts junction samples
+int32_t wall_error;        // mm, positive when the robot is nearer the right wall
+int32_t wall_read(void){   // wait for new IR samples, find the walls and the centring error
+    static uint32_t count=0;
+    uint32_t n,nr,nc,nl;
+    int32_t left,center,right;
+    do{
+        n = ADC_Latest17_12_16(&nr,&nc,&nl);
+    }while(n == count);    // a new sample every millisecond
+    count = n;
+    left = LeftConvert(nl);
+    center = CenterConvert(nc);
+    right = RightConvert(nr);
+    walls = 0;
+    if(left < WALL_OPEN) walls |= 0x04;
+    if(center < WALL_BLOCK) walls |= 0x02;
+    if(right < WALL_OPEN) walls |= 0x01;
+    if((walls&0x05) == 0x05) wall_error = (left-right)/2; // corridor: stay in the middle
+    else if(walls&0x04) wall_error = left-WALL_SET;       // only a left wall
+    else if(walls&0x01) wall_error = WALL_SET-right;      // only a right wall
+    else wall_error = 0;
+    if(wall_error > 100) wall_error = 100;
+    if(wall_error < -100) wall_error = -100;
+    if(walls == 0x05) seen = 0;  // plain corridor
+    else if(seen < WALL_CONFIRM) seen++;
+    return wall_error;
+}
+void wall_steer(void){     // centre between the walls
+    Motor_Forward(3700-WALL_KP*wall_error,3700+WALL_KP*wall_error);
+}
+void wall_follow(void){    //MOD 1 for walls, left hand rule, same S B L R decisions as the line
+        wall_read();
+        wall_steer();
+        if(seen == WALL_CONFIRM){          // an opening or a wall ahead
+            Boundary = line_steps();       // the segment ends at this junction, as in line_step()
+            if((walls&0x04) == 0){         // left is open
+                Motor_Forward(4000,4000);
+                TimedPause(200);
+                Motor_Left(5000,5000);
+                flag=3;
+                TimedPause(350);
+            }
+            else if((walls&0x02) == 0){    // front is open, straight on
+                flag=1;
+            }
+            else if((walls&0x01) == 0){    // only right is open
+                Motor_Forward(4000,4000);
+                TimedPause(200);
+                Motor_Right(5000,5000);
+                flag=4;
+                TimedPause(350);
+            }
+            else{                          // dead end
+                Motor_Left(5000,5000);
+                flag=2;
+                TimedPause(700);
+            }
+            Motor_Forward(4000,4000);      // leave the junction before looking again
+            TimedPause(WALL_CLEAR);
+            seen = 0;
+        }
+        path_record(walls, wall_error);
+}
+void wall_replay(void){    //MOD 2 for walls, take the next saved turn at every junction
+        wall_read();
+        wall_steer();
+        Recorder_Log(walls, wall_error, path_letter());
+        if(seen == WALL_CONFIRM){
+           if(path_letter() == 0){         // the path is used up, stop at this junction
+               Motor_Stop();
+               Finished = 1;
+               return;
+           }
+           switch(path_letter()){
                case 'L':
                         Motor_Forward(4000,4000);
                         TimedPause(200);
                         Motor_Left(4000,4000);
                         TimedPause(350);
                         break;
-               case 'S':
-                        Motor_Forward(4000,4000);
-                        TimedPause(200);
-                        Motor_Forward(4000,4000);
-                        TimedPause(350);
-                        break;
                case 'R':
                         Motor_Forward(4000,4000);
                         TimedPause(200);
@@ -297,20 +572,21 @@ void RFL_2(void){                           //MOD 2 read the directions that we
                         TimedPause(350);
                         break;
            }
+           Motor_Forward(4000,4000);
+           TimedPause(WALL_CLEAR);
+           seen = 0;
            ii--;
-       }
+        }
 }
 
 
-
-void endstop(void){
-    Data = Reflectance_Read(1000);
-    if(Data == 0xDB){
+uint8_t endstop(void){      // line_step() stops on the finish marker 0xDB
+    if(Finished){
         Motor_Stop();
-        while(LaunchPad_Input()==0);  // wait for touch
-        while(LaunchPad_Input());
+        Recorder_Save(RECORDER_FINISH);   // keep the flight recording of this run
+        return 1;
     }
-
+    return 0;
 }
 //bump and driver
 /*uint8_t bumprun(void){
@@ -350,47 +626,132 @@ uint8_t bumprun1(void){
         // TimedPause(300);// SysTick_Wait10ms(30);
          //Motor_Right(4000,3900);
         TimedPause(400);// SysTick_Wait10ms(30);
+        Recorder_Save(RECORDER_BUMP);     // keep the flight recording of this run
          return 1;
         }
         else return 0;
 
+}
+// clear the profiling zones and name the ones this program uses
+void profile_names(void){
+  Profile_Init();
+  Profile_Name(ZONE_STEP, "step");
+  Profile_Name(ZONE_READ, "Reflectance_End");
+  Profile_Name(ZONE_MOTOR, "line_drive");
 }
   int main(void){
-      char i=0,leng;
-      const char *substr[6]={"LBR","LBS","RBL","SBL","SBS","LBL"}; //these strings can be replaced by
-      const char *keys[6]={"B","R","B","R","B","S"};               //these strings  it's just a wonderful trick
+      char i=0;
+      uint8_t button;
       Clock_Init48MHz();
        LaunchPad_Init(); // built-in switches and LEDs
        Bump_Init();      // bump switches
        Motor_Init();     // your function
        PWM_Init34(10000, 5000, 7000);
        Reflectance_Init();
-       while(LaunchPad_Input()==0);  // wait for touch
-       while(LaunchPad_Input());     // wait for release
+#ifdef STRIPCHART
+       Nokia5110_Init();
+       StripChart_Init();
+#endif
+       Tachometer_Init();
+       EUSCIA0_Init();     // interrupt-driven serial port for the shell and the dumps
+       Recorder_Init();
+       FlashStore_Init();  // find the path saved by an earlier run
+       Shell_Init(Params, sizeof(Params)/sizeof(Params[0])); // saved tuning replaces the defaults
+#ifdef WALLMAZE
+       IRDistance_Init();  // calibration tables saved by IRDistance_Calibrate
+       ADC0_InitTimerTriggerCh17_12_16(12000); // IR sensors at 1 kHz
+#endif
+       Scheduler_Init(48000, 7); // 1 ms tick wakes the delays, which sleep
+       TimerWheel_Init();
+       Scheduler_OnTick(&TimerWheel_Tick); // software timers run on the same 1 ms tick
+       profile_names();
+       EnableInterrupts();
+       do{
+         while(LaunchPad_Input()==0){  // wait for touch
+           FlashStore_Background();    // finish any flash erase while idle
+           TimerWheel_Run();           // deferred software timer tasks
+           Shell_Run();                // tune parameters over the serial port
+           Clock_Sleep();              // until the next tick
+         }
+         button = 0;
+         while(LaunchPad_Input()){     // wait for release
+           button |= LaunchPad_Input();// SW1 explores, SW2 replays the saved path
+         }
+         if(button == 0x03){
+           Recorder_Dump();            // both: send the last flight recording to the PC
+           Profile_Dump();             //       and the times measured since reset
+           EUSCIA0_OutString("idle us,"); EUSCIA0_OutUDec(Clock_Idle_us());
+           EUSCIA0_OutString(",of us,");  EUSCIA0_OutUDec(Clock_Now_us());
+           EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+           Bench_Format();             //       and the library benchmarks
+           Bench_Nokia5110();
+           Bench_IRDistance();
+           profile_names();            //       which took over the zones
+         }
+       }while(button == 0x03);
+       if((button == 0x02) && (FlashStore_Read(FLASHSTORE_PATH, path_maze, sizeof(path_maze)) > 0)){
+         path_maze[sizeof(path_maze)-1] = '\0';
+         if(FlashStore_Read(FLASHSTORE_SEGMENTS, path_len, sizeof(path_len)) != 2*(strlen(path_maze)+1)){
+           memset(path_len, 0, sizeof(path_len)); // no lengths for this path, replay at JunctionRpm
+         }
+       } else{
     // write a main program that uses PWM to move the robot
     // like Program13_1, but uses TimerA1 to periodically
     // check the bump switches, stopping the robot on a collision
+#ifdef WALLMAZE
+  SegStart = Boundary = line_steps();
+  while(1){
+      PROFILE_BEGIN(ZONE_STEP);
+      wall_follow();        //MOD 1 run around in the maze of walls
+      PROFILE_END(ZONE_STEP);
+      if(bumprun1()==1) break;//if it bumped then stop and wait for a touch
+  }
+#else
+  line_run(Explore, &line_input, 0); //MOD 1 run around in the maze
   while(1){
-      reflactance();        //MOD 1 run around in the maze
+      if((Scheduler_Dispatch()==0)&&(TimerWheel_Run()==0)) Scheduler_Sleep();
+      if(endstop()==1) break;  //at the finish stop and wait for a touch
       if(bumprun1()==1) break;//if it bumped then stop and wait for a touch
   }
+  line_stop();
+#endif
   path_maze[ii]='\0';
-  do
-     {
-         leng=strlen(path_maze);
-         for (i=0;i<6;i++) ReplaceSubStr(path_maze,substr[i],keys[i],path_maze);
-     }while (strlen(path_maze)<leng);
+  Boundary=line_steps();
+  path_len[ii]=path_segment();  // the last segment runs to where it stopped
+  path_reduce();
      for (i=0;i<strlen(path_maze);i++) {
          if (path_maze[i]=='L') path_maze[i]='R';
          else if (path_maze[i]=='R') path_maze[i]='L';
      }
-  ii=strlen(path_maze)-1;
+  FlashStore_Write(FLASHSTORE_PATH, path_maze, strlen(path_maze)+1); // keep it across power cycles
+  FlashStore_Write(FLASHSTORE_SEGMENTS, path_len, 2*(strlen(path_maze)+1));
   while(LaunchPad_Input()==0);  // wait for touch
   while(LaunchPad_Input());     // wait for release
-  while(1){
-          RFL_2();
-
-   }
+       }
+  while(1){                     // each touch replays the path again from the start
+    ii=strlen(path_maze)-1;
+    Recorder_Init();            // record the replay
+#ifdef WALLMAZE
+    Finished = 0;
+#else
+    line_run(Replay, &replay_input, 1);   //MOD 2 take the saved turn at every junction, at profiled speed
+#endif
+    while(1){
+#ifdef WALLMAZE
+          wall_replay();
+#else
+          if((Scheduler_Dispatch()==0)&&(TimerWheel_Run()==0)) Scheduler_Sleep();
+#endif
+          if(endstop()==1) break;   // finished: stopped, the recording is saved
+          if(bumprun1()==1) break;  // crashed: the recording is saved
+    }
+#ifndef WALLMAZE
+    line_stop();                // no line tasks left to drive the motors
+#endif
+    Motor_Stop();
+    while(LaunchPad_Input()==0);  // wait for touch
+    while(LaunchPad_Input());     // wait for release
+  }
 }
 
 
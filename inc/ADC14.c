@@ -46,6 +46,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/ADC14.h"
+#include "../inc/Timers.h"
 // P4.7 = A6
 // single conversion, 3.3V reference
 void ADC0_InitSWTriggerCh6(void){
@@ -177,7 +178,16 @@ void ADC_In67(uint32_t *ch6, uint32_t *ch7){
 // P4.1 = A12
 // single conversion, 3.3V reference
 void ADC0_InitSWTriggerCh12(void){
-    // write this for Lab 15
+  ADC14->CTL0 &= ~0x00000002;        // 2) ADC14ENC = 0 to allow programming
+  while(ADC14->CTL0&0x00010000){};   // 3) wait for BUSY to be zero
+  ADC14->CTL0 = 0x04203310;          // 4) single, SMCLK, on, disabled, /1, 32 SHM
+  ADC14->CTL1 = 0x00000030;          // 5) ADC14MEM0, 14-bit, ref on, regular power
+  ADC14->MCTL[0] = 0x0000008C;       // 6) 0 to 3.3V, end of sequence, channel 12
+  ADC14->IER0 = 0;                   // 7) no interrupts
+  ADC14->IER1 = 0;                   //    no interrupts
+  P4->SEL1 |= 0x02;                  // 8) analog mode on A12, P4.1
+  P4->SEL0 |= 0x02;
+  ADC14->CTL0 |= 0x00000002;         // 9) enable
 }
 // ADC14IFGR0 bit 0 is set when P4.1 = A12 conversion done
 //                  cleared on read ADC14MEM0
@@ -185,8 +195,10 @@ void ADC0_InitSWTriggerCh12(void){
 // ADC14IVx is 0x0C when ADC14MEM0 interrupt flag; Interrupt Flag: ADC14IFG0
 // ADC14MEM0 14-bit conversion in bits 13-0 (31-16 undefined, 15-14 zero)
 uint32_t ADC_In12(void){
-    // write this for Lab 15
-    return 0; // replace this line
+  while(ADC14->CTL0&0x00010000){};    // 1) wait for BUSY to be zero
+  ADC14->CTL0 |= 0x00000001;          // 2) start single conversion
+  while((ADC14->IFGR0&0x01) == 0){};  // 3) wait for ADC14IFG0
+  return ADC14->MEM[0];               // 4) return result 0 to 16383
 }
 
 // P9.0 = A17
@@ -194,7 +206,21 @@ uint32_t ADC_In12(void){
 // P9.1 = A16
 // Lab 15 assignment, use software trigger, 3.3V reference
 void ADC0_InitSWTriggerCh17_12_16(void){
-    // write this for Lab 15
+  ADC14->CTL0 &= ~0x00000002;      // 2) ADC14ENC = 0 to allow programming
+  while(ADC14->CTL0&0x00010000){}; // 3) wait for BUSY to be zero
+  ADC14->CTL0 = 0x04223390;        // 4) sequence, SMCLK, on, disabled, /1, 32 SHM, MSC
+  ADC14->CTL1 = 0x00020030;        // 5) ADC14MEM2, 14-bit, ref on, regular power
+  // 20-16 STARTADDx  start addr          00010b = ADC14MEM2
+  ADC14->MCTL[2] = 0x00000011;     // 6a) 0 to 3.3V, channel 17
+  ADC14->MCTL[3] = 0x0000000C;     // 6b) 0 to 3.3V, channel 12
+  ADC14->MCTL[4] = 0x00000090;     // 6c) 0 to 3.3V, end of sequence, channel 16
+  ADC14->IER0 = 0;                 // 7) no interrupts
+  ADC14->IER1 = 0;                 //    no interrupts
+  P9->SEL1 |= 0x03;                // 8) analog mode on P9.0/A17 and P9.1/A16
+  P9->SEL0 |= 0x03;
+  P4->SEL1 |= 0x02;                //    analog mode on P4.1/A12
+  P4->SEL0 |= 0x02;
+  ADC14->CTL0 |= 0x00000002;       // 9) enable
 }
 
 // ADC14IFGR0 bit 4 is set when conversion done
@@ -205,6 +231,120 @@ void ADC0_InitSWTriggerCh17_12_16(void){
 // ADC14MEM3 14-bit conversion in bits 13-0 (31-16 undefined, 15-14 zero)
 // ADC14MEM4 14-bit conversion in bits 13-0 (31-16 undefined, 15-14 zero)
 void ADC_In17_12_16(uint32_t *ch17, uint32_t *ch12, uint32_t *ch16){
-// write this for Lab 15
+  while(ADC14->CTL0&0x00010000){}; // 1) wait for BUSY to be zero
+  ADC14->CTL0 |= 0x00000001;       // 2) start single conversion
+  while((ADC14->IFGR0&0x10) == 0){}; // 3) wait for ADC14IFG4
+  *ch17 = ADC14->MEM[2];           // 4) P9.0/A17 result 0 to 16383
+  *ch12 = ADC14->MEM[3];           //    P4.1/A12 result 0 to 16383
+  *ch16 = ADC14->MEM[4];           //    P9.1/A16 result 0 to 16383
+}
+
+//**********timer-triggered IR sequence**************
+// Timer A1 CCR1 output rises once per period and starts one
+// sequence of 12 conversions: A17, A12, A16 repeated
+// ADC_OVERSAMPLE times, back to back (MSC=1), about 4 us
+// apart.  The ADC14 has no hardware averaging, so the
+// interrupt on the last conversion adds the samples of each
+// channel and stores the averages in the back half of a
+// double buffer, then swaps the halves.  Readers never wait.
+#define ADC_OVERSAMPLE 4           // samples per channel per trigger
+struct ADCIRSample{
+  uint32_t ch17, ch12, ch16;
+};
+static struct ADCIRSample IRBuffer[2];
+static volatile uint32_t IRFront;  // half of IRBuffer that readers use
+static volatile uint32_t IRCount;  // number of completed sequences
+static int IRTimer = -1;           // Timer A1 from Timers_Request()
+
+// P9.0 = A17
+// P4.1 = A12
+// P9.1 = A16
+// Timer A1 trigger, 3.3V reference
+// does nothing if another driver holds Timer A1
+void ADC0_InitTimerTriggerCh17_12_16(uint16_t period){
+  uint32_t i;
+  if(IRTimer < 0){
+    IRTimer = Timers_Request(TIMERS_TA1, TIMERS_PWM, 0, 0);
+    if(IRTimer < 0){
+      return;                      // Timer A1 is in use
+    }
+  }
+  ADC14->CTL0 &= ~0x00000002;      // 2) ADC14ENC = 0 to allow programming
+  while(ADC14->CTL0&0x00010000){}; // 3) wait for BUSY to be zero
+  ADC14->CTL0 = 0x1C223390;        // 4) sequence, SMCLK, on, disabled, /1, 32 SHM, MSC, TA1_C1
+  // 31-30 ADC14PDIV  predivider,            00b = Predivide by 1
+  // 29-27 ADC14SHSx  SHM source            011b = TA1_C1
+  // 26    ADC14SHP   SHM pulse-mode          1b = SAMPCON the sampling timer
+  // 25    ADC14ISSH  invert sample-and-hold  0b = not inverted
+  // 24-22 ADC14DIVx  clock divider         000b = /1
+  // 21-19 ADC14SSELx clock source select   100b = SMCLK
+  // 18-17 ADC14CONSEQx mode select          01b = Sequence-of-channels
+  // 16    ADC14BUSY  ADC14 busy              0b (read only)
+  // 15-12 ADC14SHT1x sample-and-hold time 0011b = 32 clocks
+  // 11-8  ADC14SHT0x sample-and-hold time 0011b = 32 clocks
+  // 7     ADC14MSC   multiple sample         1b = whole sequence on one trigger
+  // 4     ADC14ON    ADC14 on                1b = powered up
+  // 1     ADC14ENC   enable conversion       0b = ADC14 disabled
+  // 0     ADC14SC    ADC14 start             0b = No start
+  ADC14->CTL1 = 0x00000030;        // 5) ADC14MEM0, 14-bit, ref on, regular power
+  for(i=0; i<3*ADC_OVERSAMPLE; i=i+3){
+    ADC14->MCTL[i] = 0x00000011;   // 6a) 0 to 3.3V, channel 17
+    ADC14->MCTL[i+1] = 0x0000000C; // 6b) 0 to 3.3V, channel 12
+    ADC14->MCTL[i+2] = 0x00000010; // 6c) 0 to 3.3V, channel 16
+  }
+  ADC14->MCTL[3*ADC_OVERSAMPLE-1] |= 0x00000080; // end of sequence
+  ADC14->IER0 = 1<<(3*ADC_OVERSAMPLE-1);  // 7) interrupt when the last conversion is done
+  ADC14->IER1 = 0;
+  P9->SEL1 |= 0x03;                // 8) analog mode on P9.0/A17 and P9.1/A16
+  P9->SEL0 |= 0x03;
+  P4->SEL1 |= 0x02;                //    analog mode on P4.1/A12
+  P4->SEL0 |= 0x02;
+  IRFront = 0;
+  IRCount = 0;
+  NVIC->IP[6] = (NVIC->IP[6]&0xFFFFFF00)|0x00000040; // priority 2
+  NVIC->ISER[0] = 0x01000000;      // enable interrupt 24 in NVIC
+  ADC14->CTL0 |= 0x00000002;       // 9) enable, waits for the first trigger
+  // Timer A1 makes a rising edge on CCR1 output every period
+  TIMER_A1->CTL &= ~0x0030;        // halt Timer A1
+  TIMER_A1->CTL = 0x0200;          // SMCLK, /1, stop mode, no interrupt
+  TIMER_A1->EX0 &= ~0x0007;        // input clock divider /1
+  TIMER_A1->CCR[0] = period - 1;   // period in units of 83.33 ns
+  TIMER_A1->CCR[1] = period/2;     // rising edge half way through
+  TIMER_A1->CCTL[0] = 0x0000;      // no interrupts
+  TIMER_A1->CCTL[1] = 0x0060;      // compare, OUTMOD=3 set/reset, no interrupt
+  TIMER_A1->CTL |= 0x0014;         // reset and start Timer A1 in up mode
+}
+
+void ADC14_IRQHandler(void){
+  struct ADCIRSample *pt = &IRBuffer[IRFront^1];
+  uint32_t i, sum17 = 0, sum12 = 0, sum16 = 0;
+  for(i=0; i<3*ADC_OVERSAMPLE; i=i+3){
+    sum17 = sum17 + ADC14->MEM[i];
+    sum12 = sum12 + ADC14->MEM[i+1];
+    sum16 = sum16 + ADC14->MEM[i+2]; // reading the last one clears its flag
+  }
+  pt->ch17 = sum17/ADC_OVERSAMPLE;
+  pt->ch12 = sum12/ADC_OVERSAMPLE;
+  pt->ch16 = sum16/ADC_OVERSAMPLE;
+  IRFront = IRFront^1;             // publish the new samples
+  IRCount = IRCount + 1;
+  ADC14->CTL0 &= ~0x00000002;      // toggle ENC so the next timer edge
+  ADC14->CTL0 |= 0x00000002;       // starts another sequence
 }
 
+// Return the most recent averaged samples without waiting.
+// The ISR only writes the half of the buffer readers are not
+// using; the count check catches the rare case of two
+// sequences finishing during one read.
+uint32_t ADC_Latest17_12_16(uint32_t *ch17, uint32_t *ch12, uint32_t *ch16){
+  uint32_t count;
+  const struct ADCIRSample *pt;
+  do{
+    count = IRCount;
+    pt = &IRBuffer[IRFront];
+    *ch17 = pt->ch17;
+    *ch12 = pt->ch12;
+    *ch16 = pt->ch16;
+  }while(count != IRCount);
+  return count;
+}
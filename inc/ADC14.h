@@ -174,4 +174,36 @@ uint32_t ADC_In12(void);
  */
 void ADC_In17_12_16(uint32_t *ch17, uint32_t *ch12, uint32_t *ch16);
 
+/**
+ * Initialize 14-bit ADC0 to convert the three IR distance
+ * sensors periodically without software triggering.
+ * Timer A1 starts one sequence every period; each sequence
+ * samples these channels back to back four times:<br>
+ * - Sample P9.0/A17(first)<br>
+ * - Sample P4.1/A12<br>
+ * - Sample P9.1/A16(last)<br>
+ * The ADC interrupt averages the four samples of each channel
+ * and stores the results in a double buffer.
+ * @param period time between sequences in units of 83.33 ns (12 MHz SMCLK), e.g., 12000 for 1 kHz
+ * @return none
+ * @note  The 3.3V analog supply is used as reference.
+ * @note  Uses Timer A1, so it does nothing if TimerA1_Init() or another driver holds it, see Timers.h
+ * @note  Interrupts must be enabled in the main program.
+ * @see ADC_Latest17_12_16()
+ * @brief  Initialize timer-triggered ADC0 sequence for IR sensors
+ */
+void ADC0_InitTimerTriggerCh17_12_16(uint16_t period);
+
+/**
+ * Return the most recent averaged samples from the timer-triggered
+ * sequence without waiting.
+ * @param ch17 is a pointer to store P9.0/A17 result 0 to 16383<br>
+ * @param ch12 is a pointer to store P4.1/A12 result 0 to 16383<br>
+ * @param ch16 is a pointer to store P9.1/A16 result 0 to 16383
+ * @return number of sequences completed; 0 means no samples yet, and an unchanged value means no new samples
+ * @note  Assumes ADC0_InitTimerTriggerCh17_12_16() has been called.
+ * @brief  Read latest IR sensor samples.
+ */
+uint32_t ADC_Latest17_12_16(uint32_t *ch17, uint32_t *ch12, uint32_t *ch16);
+
 #endif /* ADC14_H_ */
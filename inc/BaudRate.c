@@ -0,0 +1,126 @@
+// BaudRate.c
+// Runs on MSP432
+// Compute eUSCI_A UART baud rate dividers with fractional
+// modulation for any clock and baud rate.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+// N = BRCLK/baud
+// N >= 16  oversampling: UCBR = int(N/16), UCBRF = int(16*frac(N/16)), UCOS16 = 1
+// N < 16   low frequency: UCBR = int(N), UCBRF = 0, UCOS16 = 0
+// UCBRS    from frac(N) with the table below, in both modes
+// An average bit lasts 16*UCBR + UCBRF + ones(UCBRS)/8 BRCLK cycles
+// with oversampling, or UCBR + ones(UCBRS)/8 without.
+
+#include <stdint.h>
+#include "../inc/Clock.h"
+#include "../inc/BaudRate.h"
+#include "msp.h"
+
+// UCBRSx setting for each fractional part of N, from the
+// MSP432P4xx Technical Reference Manual; the fraction is in
+// units of 1/10000 and the last entry not above frac(N) is used
+static const struct{
+  uint16_t frac;
+  uint8_t brs;
+} Modulation[] = {
+  {   0,0x00}, { 529,0x01}, { 715,0x02}, { 835,0x04}, {1001,0x08}, {1252,0x10},
+  {1430,0x20}, {1670,0x11}, {2147,0x21}, {2224,0x22}, {2503,0x44}, {3000,0x25},
+  {3335,0x49}, {3575,0x4A}, {3753,0x52}, {4003,0x92}, {4286,0x53}, {4378,0x55},
+  {5002,0xAA}, {5715,0x6B}, {6003,0xAD}, {6254,0xB5}, {6432,0xB6}, {6667,0xD6},
+  {7001,0xB7}, {7147,0xBB}, {7503,0xDD}, {7861,0xED}, {8004,0xEE}, {8333,0xBF},
+  {8464,0xDF}, {8572,0xEF}, {8751,0xF7}, {9004,0xFB}, {9170,0xFD}, {9288,0xFE}
+};
+#define MODULATIONS (sizeof(Modulation)/sizeof(Modulation[0]))
+
+//------------BaudRate_Divider------------
+// Compute the UCAxBRW and UCAxMCTLW values for a baud rate.
+// Input: brclk  UART clock frequency in Hz
+//        baud   desired baud rate in bits/sec
+//        brw    where to store UCAxBRW
+//        mctlw  where to store UCAxMCTLW
+// Output: error of the average bit rate in ppm, positive if
+//         faster than requested, or BAUDRATE_BAD if BRCLK is
+//         less than 3 times the baud rate
+int32_t BaudRate_Divider(uint32_t brclk, uint32_t baud, uint16_t *brw, uint16_t *mctlw){
+  uint32_t n, frac, br, brf, brs, os16, bits, ones, i;
+  uint64_t actual;
+  if((baud == 0) || (brclk/3 < baud)){
+    return BAUDRATE_BAD;
+  }
+  n = brclk/baud;                                    // integer part of N
+  frac = (uint32_t)(((uint64_t)(brclk%baud)*10000)/baud); // fractional part of N in 1/10000
+  if(n >= 16){
+    os16 = 1;
+    br = n/16;
+    brf = (n%16);                                    // int(16*frac(N/16)), the fraction of N does not reach it
+  } else{
+    os16 = 0;
+    br = n;
+    brf = 0;
+  }
+  if(br > 0xFFFF){
+    return BAUDRATE_BAD;
+  }
+  i = 0;
+  while((i+1 < MODULATIONS) && (Modulation[i+1].frac <= frac)){
+    i = i + 1;
+  }
+  brs = Modulation[i].brs;
+  ones = 0;
+  for(bits=brs; bits; bits=bits>>1){
+    ones = ones + (bits&1);
+  }
+  // average bit time in 1/8 BRCLK cycles, then actual/requested - 1 in ppm
+  bits = 8*(os16 ? (16*br + brf) : br) + ones;
+  actual = ((uint64_t)brclk*8*1000000)/((uint64_t)bits*baud);
+  *brw = br;
+  *mctlw = (brs<<8)|(brf<<4)|os16;
+  return (int32_t)actual - 1000000;
+}
+
+//------------BaudRate_SMCLK------------
+// Return the SMCLK frequency from the bus clock and the
+// SMCLK divider (DIVS, CS_CTL1 bits 30-28).
+// Input: none
+// Output: SMCLK frequency in Hz
+uint32_t BaudRate_SMCLK(void){
+  return Clock_GetFreq()>>((CS->CTL1>>28)&0x07);
+}
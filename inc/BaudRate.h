@@ -0,0 +1,93 @@
+/**
+ * @file      BaudRate.h
+ * @brief     Compute eUSCI_A UART baud rate dividers
+ * @details   Finds the UCBRx, UCBRFx and UCBRSx settings and the
+ * oversampling mode for any baud rate from the BRCLK frequency,
+ * following the algorithm in the MSP432P4xx Technical Reference
+ * Manual.  The integer part of BRCLK/baud sets the prescaler, the
+ * fractional part selects the second modulation stage pattern
+ * from the manual's table, and the error of the average bit time
+ * is returned so the caller knows how close it got.<br>
+ * The UART runs from SMCLK, 12 MHz after Clock_Init48MHz(), so
+ * 4,000,000 baud (BRCLK/baud = 3) is the fastest rate and 1, 1.5,
+ * 2 and 3 Mbaud divide evenly.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef BAUDRATE_H_
+#define BAUDRATE_H_
+
+/**
+ * \brief error returned when the baud rate cannot be generated
+ */
+#define BAUDRATE_BAD ((int32_t)0x80000000)
+
+/**
+ * Compute the eUSCI_A divider registers for a baud rate.  The
+ * values are only written to brw and mctlw if the rate can be
+ * generated, which needs BRCLK to be at least 3 times the baud rate.
+ * @param brclk is the UART clock frequency in Hz
+ * @param baud is the desired baud rate in bits/sec
+ * @param brw is where to store the UCAxBRW value
+ * @param mctlw is where to store the UCAxMCTLW value
+ * @return error of the average bit rate in parts per million,
+ * positive if faster than requested, or BAUDRATE_BAD
+ * @brief  Compute UART dividers
+ */
+int32_t BaudRate_Divider(uint32_t brclk, uint32_t baud, uint16_t *brw, uint16_t *mctlw);
+
+/**
+ * Return the SMCLK frequency, the bus clock from Clock_GetFreq()
+ * divided by the SMCLK divider in the clock system.
+ * @param  none
+ * @return SMCLK frequency in Hz
+ * @note   assumes SMCLK and MCLK share a source, as set up by
+ * Clock_Init48MHz() and at reset
+ * @brief  Get the SMCLK frequency
+ */
+uint32_t BaudRate_SMCLK(void);
+
+#endif // BAUDRATE_H_
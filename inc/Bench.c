@@ -0,0 +1,238 @@
+// Bench.c
+// Runs on MSP432
+// Cycle benchmarks of library functions on the robot, each
+// timed with the Profile zones against a reference version.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/EUSCIA0.h"
+#include "../inc/Profile.h"
+#include "../inc/Format.h"
+#include "../inc/IRDistance.h"
+#include "../inc/Nokia5110.h"
+#include "../inc/Bench.h"
+
+static uint32_t Seed;
+// numbers with 1 to 10 digits, from a linear congruential generator
+static uint32_t number(void){
+  Seed = 1664525*Seed + 1013904223;
+  return Seed>>(Seed&31);
+}
+
+// coordinate from lo to lo+span-1, a few off the screen to exercise clipping
+static int32_t coord(int32_t lo, uint32_t span){
+  Seed = 1664525*Seed + 1013904223;
+  return lo + (int32_t)(((Seed>>16)*span)>>16);
+}
+
+// reference formatter, one divide and one modulo per digit
+static int udecDivide(char *buf, uint32_t n){char tmp[10]; int i=0, len=0;
+  do{
+    tmp[i] = '0' + n%10;
+    n = n/10;
+    i = i + 1;
+  }while(n);
+  while(i){
+    i = i - 1;
+    buf[len] = tmp[i];
+    len = len + 1;
+  }
+  buf[len] = 0;
+  return len;
+}
+
+// reference fixed-point formatter, divides by 10^decimals
+static int ufixDivide(char *buf, uint32_t n, uint32_t decimals){int len, i;
+  uint32_t scale = 1;
+  for(i=0; i<decimals; i++){
+    scale = scale*10;
+  }
+  len = udecDivide(buf, n/scale);
+  buf[len] = '.';
+  n = n%scale;
+  for(i=decimals; i>0; i--){
+    buf[len+i] = '0' + n%10;
+    n = n/10;
+  }
+  len = len + 1 + decimals;
+  buf[len] = 0;
+  return len;
+}
+
+// reference IR conversion, the typical GP2Y0A21YK0F formula with one divide
+static int32_t irDivide(int32_t n){
+  if(n < 2631){
+    return IRDISTANCE_TOOFAR;      // same range as the typical table
+  }
+  if(n > 15998){
+    return IRDISTANCE_TOOCLOSE;
+  }
+  return 1195172/(n - 1058) + 40;
+}
+
+//------------Bench_Format------------
+// Time Format_UDec() and Format_UFix() against formatting
+// with divide and modulo, then send the zones over EUSCIA0.
+// Input: none
+// Output: none
+// Assumes: EUSCIA0_Init() has been called
+void Bench_Format(void){int i; uint32_t n;
+  char buf[FORMAT_SIZE];
+  Profile_Init();
+  Profile_Name(0, "Format_UDec");
+  Profile_Name(1, "udec divide");
+  Profile_Name(2, "Format_UFix");
+  Profile_Name(3, "ufix divide");
+  Seed = 1;
+  for(i=0; i<BENCH_CALLS; i++){
+    n = number();                  // same number through each version
+    PROFILE_BEGIN(0);
+    Format_UDec(buf, n, 0);
+    PROFILE_END(0);
+    PROFILE_BEGIN(1);
+    udecDivide(buf, n);
+    PROFILE_END(1);
+    PROFILE_BEGIN(2);
+    Format_UFix(buf, n, 2, 0);
+    PROFILE_END(2);
+    PROFILE_BEGIN(3);
+    ufixDivide(buf, n, 2);
+    PROFILE_END(3);
+  }
+  Profile_Dump();
+}
+
+//------------Bench_Nokia5110------------
+// Time each buffer drawing primitive of Nokia5110 over
+// random coordinates, partly off the screen, with pixel
+// loops for comparison.  Then draw one of each into a
+// clear buffer and send it as a PBM image, followed by
+// the zones, over EUSCIA0.
+// Input: none
+// Output: none
+// Assumes: EUSCIA0_Init() has been called
+void Bench_Nokia5110(void){int i; int32_t x0, x1, y0, y1, k;
+  Profile_Init();
+  Profile_Name(0, "DrawHLine");
+  Profile_Name(1, "hline SetPxl");
+  Profile_Name(2, "DrawVLine");
+  Profile_Name(3, "vline SetPxl");
+  Profile_Name(4, "DrawLine");
+  Profile_Name(5, "DrawRect");
+  Profile_Name(6, "FillRect");
+  Profile_Name(7, "DrawString");
+  Seed = 1;
+  for(i=0; i<BENCH_CALLS; i++){
+    x0 = coord(-8, 100); x1 = coord(x0, 100-8-x0); // x0 <= x1
+    y0 = coord(-8, 64);  y1 = coord(y0, 64-8-y0);  // y0 <= y1
+    PROFILE_BEGIN(0);
+    Nokia5110_DrawHLine(x0, x1, y0, PIXEL_XOR);
+    PROFILE_END(0);
+    PROFILE_BEGIN(1);              // the same line on the screen, one pixel at a time
+    if((y0 >= 0) && (y0 < 48)){
+      for(k=x0; k<=x1; k++){
+        if((k >= 0) && (k < 84)){
+          Nokia5110_SetPxl(y0, k);
+        }
+      }
+    }
+    PROFILE_END(1);
+    PROFILE_BEGIN(2);
+    Nokia5110_DrawVLine(x0, y0, y1, PIXEL_XOR);
+    PROFILE_END(2);
+    PROFILE_BEGIN(3);
+    if((x0 >= 0) && (x0 < 84)){
+      for(k=y0; k<=y1; k++){
+        if((k >= 0) && (k < 48)){
+          Nokia5110_SetPxl(k, x0);
+        }
+      }
+    }
+    PROFILE_END(3);
+    PROFILE_BEGIN(4);
+    Nokia5110_DrawLine(x0, y0, x1, y1, PIXEL_XOR);
+    PROFILE_END(4);
+    PROFILE_BEGIN(5);
+    Nokia5110_DrawRect(x0, y0, x1-x0+1, y1-y0+1, PIXEL_XOR);
+    PROFILE_END(5);
+    PROFILE_BEGIN(6);
+    Nokia5110_FillRect(x0, y0, x1-x0+1, y1-y0+1, PIXEL_XOR);
+    PROFILE_END(6);
+    PROFILE_BEGIN(7);
+    Nokia5110_DrawString(x0, y0, "RSLK");
+    PROFILE_END(7);
+  }
+  // one of each, to check the drawing in the PBM image
+  Nokia5110_ClearBuffer();
+  Nokia5110_DrawRect(0, 0, 84, 48, PIXEL_ON);
+  Nokia5110_DrawHLine(2, 81, 2, PIXEL_ON);
+  Nokia5110_DrawVLine(2, 3, 45, PIXEL_ON);
+  Nokia5110_DrawLine(4, 45, 81, 4, PIXEL_ON);
+  Nokia5110_FillRect(60, 30, 20, 14, PIXEL_ON);
+  Nokia5110_FillRect(64, 34, 12, 6, PIXEL_XOR);
+  Nokia5110_DrawString(5, 5, "RSLK 84x48");
+  Nokia5110_OutBufferPBM(&EUSCIA0_OutChar);
+  Profile_Dump();
+}
+
+//------------Bench_IRDistance------------
+// Time IRDistance_Convert() against the divide-based formula
+// over random 14-bit samples, then send the zones over EUSCIA0.
+// Input: none
+// Output: none
+// Assumes: EUSCIA0_Init() and FlashStore_Init() have been called
+void Bench_IRDistance(void){int i; int32_t n;
+  IRDistance_Init();               // saved or typical tables
+  Profile_Init();
+  Profile_Name(0, "IRDistance_Convert");
+  Profile_Name(1, "ir divide");
+  Seed = 1;
+  for(i=0; i<BENCH_CALLS; i++){
+    n = coord(0, 16384);           // same sample through each version
+    PROFILE_BEGIN(0);
+    IRDistance_Convert(IR_CENTER, n);
+    PROFILE_END(0);
+    PROFILE_BEGIN(1);
+    irDivide(n);
+    PROFILE_END(1);
+  }
+  Profile_Dump();
+}
@@ -0,0 +1,108 @@
+/**
+ * @file      Bench.h
+ * @brief     Cycle benchmarks of library functions on the robot
+ * @details   Each benchmark clears the Profile zones, times a set of
+ * library calls with PROFILE_BEGIN/PROFILE_END, and sends the
+ * results with Profile_Dump().  A reference version written the
+ * obvious way (with divides) is timed alongside, so the gain of the
+ * optimized code can be read from one dump.  A host or simulator
+ * build can define PROFILE_CYCLES() to read its own cycle counter.  The benchmarks take
+ * over the Profile zones, so call Profile_Init() and name the
+ * application zones again afterwards.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/**
+ * \brief number of calls timed for each zone
+ */
+#define BENCH_CALLS 1000
+
+/**
+ * Time Format_UDec() and Format_UFix() against formatting with
+ * divide and modulo, over numbers with 1 to 10 digits.
+ * Zone 0 is Format_UDec, 1 is the divide version, 2 is
+ * Format_UFix with 2 decimals and 3 is its divide version.
+ * @param none
+ * @return none
+ * @note  Assumes EUSCIA0_Init() has been called, clears the Profile zones
+ * @brief  Benchmark the number formatter
+ */
+void Bench_Format(void);
+
+/**
+ * Time the buffer drawing primitives of Nokia5110 over random
+ * coordinates, some off the screen, against drawing the same
+ * horizontal and vertical lines one pixel at a time.  Zones are
+ * 0 DrawHLine, 1 its SetPxl loop, 2 DrawVLine, 3 its SetPxl loop,
+ * 4 DrawLine, 5 DrawRect, 6 FillRect and 7 DrawString.  Then a
+ * test picture with one of each is drawn into a clear buffer and
+ * sent as a PBM image before the zones, so the output can be
+ * checked by eye or against an image from a host build.
+ * @param none
+ * @return none
+ * @note  Assumes EUSCIA0_Init() has been called, clears the Profile zones
+ *        and overwrites the Nokia5110 screen buffer
+ * @brief  Benchmark the LCD drawing primitives
+ */
+void Bench_Nokia5110(void);
+
+/**
+ * Time IRDistance_Convert(), a binary search and interpolation
+ * in the calibration table, against the divide-based formula of
+ * the typical sensor, D = 1195172/(n - 1058) + 40, over random
+ * 14-bit samples.  Zone 0 is the table and 1 the formula.
+ * @param none
+ * @return none
+ * @note  Assumes EUSCIA0_Init() and FlashStore_Init() have been called,
+ *        loads the tables with IRDistance_Init() and clears the Profile zones
+ * @brief  Benchmark the IR distance conversion
+ */
+void Bench_IRDistance(void);
+
+#endif /* BENCH_H_ */
@@ -43,8 +43,26 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/Timers.h"
 
 uint32_t ClockFrequency = 3000000; // cycles/second
+// Timer32 2 is the time base once the clock is 48 MHz: it counts
+// down from 47999999 at the bus clock and reloads every second
+#define TICKSPERSEC 48000000
+static volatile uint32_t Seconds = 0; // whole seconds since Clock_Init48MHz
+static int TimeRunning = 0;        // non-zero once Timer32 2 is running
+static int Timer = -1;             // Timer32 2 from Timers_Request()
+
+// count a reload of Timer32 2, call with interrupts disabled
+static void clockwrap(void){
+  if(TIMER32_2->RIS&0x00000001){
+    TIMER32_2->INTCLR = 0x00000001;     // acknowledge Timer32 2 interrupt
+    Seconds = Seconds + 1;
+  }
+}
+
+static uint32_t IdleTime = 0;      // us spent sleeping in Clock_Sleep
 //static uint32_t SubsystemFrequency = 3000000; // cycles/second
 
 // ------------Clock_InitFastest------------
@@ -127,6 +145,52 @@ void Clock_Init48MHz(void){
   CS->KEY = 0;                          // lock CS module from unintended access
   ClockFrequency = 48000000;
 //  SubsystemFrequency = 12000000;
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_T32_2, TIMERS_PERIODIC, &clockwrap, 0);
+    if(Timer < 0){
+      return;                           // Timer32 2 is in use, delays stay busy-wait loops
+    }
+  }
+  TIMER32_2->CONTROL = 0;               // disable Timer32 2 during setup
+  TIMER32_2->LOAD = TICKSPERSEC - 1;    // reload every second
+  TIMER32_2->INTCLR = 0x00000001;       // clear Timer32 2 interrupt
+  // bits31-8=X...X,   reserved
+  // bit7=1,           timer enable
+  // bit6=1,           timer in periodic mode
+  // bit5=1,           interrupt enable
+  // bit4=X,           reserved
+  // bits3-2=00,       input clock divider /1
+  // bit1=1,           32-bit counter
+  // bit0=0,           wrapping mode
+  TIMER32_2->CONTROL = 0x000000E2;
+  NVIC->IP[6] = (NVIC->IP[6]&0xFF00FFFF)|0x00E00000; // priority 7
+  NVIC->ISER[0] = 0x04000000;           // enable interrupt 26 in NVIC
+  Seconds = 0;
+  TimeRunning = 1;
+}
+
+// ------------Clock_Now_us------------
+// Return the time since Clock_Init48MHz() was called.
+// It counts up monotonically and wraps every 71.6 minutes,
+// so compare times by subtracting them.  Timer32 2 is polled
+// as well, so this works with interrupts disabled.
+// Inputs: none
+// Outputs: time in us, 0 if Clock_Init48MHz() has not succeeded
+uint32_t Clock_Now_us(void){
+  uint32_t count, sec; long sr;
+  if(TimeRunning == 0){
+    return 0;
+  }
+  sr = StartCritical();
+  clockwrap();
+  count = TIMER32_2->VALUE;
+  if(TIMER32_2->RIS&0x00000001){        // reloaded just before reading
+    clockwrap();
+    count = TIMER32_2->VALUE;
+  }
+  sec = Seconds;
+  EndCritical(sr);
+  return sec*1000000 + (TICKSPERSEC - 1 - count)/48;
 }
 
 // ------------Clock_GetFreq------------
@@ -148,11 +212,78 @@ void delay(unsigned long ulCount){
       "    bne    pdloop\n");
 }
 
+// ------------Clock_DelayUntil_us------------
+// Busy-wait until the given time.  Interrupts that run
+// while waiting do not make the delay longer.
+// Inputs: deadline, time from Clock_Now_us() to wait for
+// Outputs: none
+void Clock_DelayUntil_us(uint32_t deadline){
+  while((int32_t)(Clock_Now_us() - deadline) < 0){};
+}
+
+// ------------Clock_Sleep------------
+// Sleep (LPM0) until the next interrupt, and add the time
+// asleep to the idle time.
+// Inputs: none
+// Outputs: none
+void Clock_Sleep(void){
+  uint32_t start = Clock_Now_us();
+  WaitForInterrupt();
+  IdleTime = IdleTime + (Clock_Now_us() - start);
+}
+
+// ------------Clock_Idle_us------------
+// Return the total time spent in Clock_Sleep().
+// Divide by Clock_Now_us() for the idle fraction.
+// Inputs: none
+// Outputs: idle time in us, wraps like Clock_Now_us()
+uint32_t Clock_Idle_us(void){
+  return IdleTime;
+}
+
+// ------------Clock_SleepUntil_us------------
+// Wait until the given time, sleeping whenever an interrupt
+// is sure to wake the processor before the deadline, and
+// busy-waiting the rest of the time.  The wake-up comes
+// from the once a second Timer32 2 interrupt, or SysTick if
+// its interrupt is running.  An interrupt service routine
+// never sleeps, because those interrupts may not preempt it.
+// The check and the sleep run with interrupts disabled, so
+// an interrupt that comes in between ends the sleep at once.
+// Inputs: deadline, time from Clock_Now_us() to wait for
+// Outputs: none
+void Clock_SleepUntil_us(uint32_t deadline){
+  int32_t left;
+  uint32_t next;
+  long sr;
+  if(TimeRunning == 0){
+    return;
+  }
+  do{
+    sr = StartCritical();              // an interrupt after the check still wakes the WFI
+    left = (int32_t)(deadline - Clock_Now_us());
+    next = TIMER32_2->VALUE/48;        // us to Timer32 2 reload
+    if(((SysTick->CTRL&0x07) == 0x07) && ((SysTick->VAL/48) < next)){
+      next = SysTick->VAL/48;          // us to SysTick interrupt
+    }
+    if((left > 0) && ((SCB->ICSR&0x1FF) == 0) && ((uint32_t)left > next)){
+      Clock_Sleep();                   // wakes on a pending interrupt
+    }
+    EndCritical(sr);                   // which runs now
+  }while(left > 0);
+}
+
 // ------------Clock_Delay1us------------
-// Simple delay function which delays about n microseconds.
+// Delay n microseconds using Timer32 2, sleeping when
+// possible.  Before the clock is running at 48 MHz, use
+// a tuned loop.
 // Inputs: n, number of us to wait
 // Outputs: none
 void Clock_Delay1us(uint32_t n){
+  if(TimeRunning){
+    Clock_SleepUntil_us(Clock_Now_us() + n);
+    return;
+  }
   n = (382*n)/100;; // 1 us, tuned at 48 MHz
   while(n){
     n--;
@@ -160,10 +291,16 @@ void Clock_Delay1us(uint32_t n){
 }
 
 // ------------Clock_Delay1ms------------
-// Simple delay function which delays about n milliseconds.
+// Delay n milliseconds using Timer32 2, sleeping when
+// possible.  Before the clock is running at 48 MHz, use
+// a tuned loop.
 // Inputs: n, number of msec to wait
 // Outputs: none
 void Clock_Delay1ms(uint32_t n){
+  if(TimeRunning){
+    Clock_SleepUntil_us(Clock_Now_us() + 1000*n);
+    return;
+  }
   while(n){
     delay(ClockFrequency/9162);   // 1 msec, tuned at 48 MHz
     n--;
@@ -49,10 +49,12 @@ policies, either expressed or implied, of the FreeBSD Project.
 */
 
 /**
- * Configure the MSP432 clock to run at 48 MHz
+ * Configure the MSP432 clock to run at 48 MHz, and start
+ * Timer32 2 as the microsecond clock used by the delays.
  * @param none
  * @return none
  * @note  Since the crystal is used, the bus clock will be very accurate
+ * @note  Uses Timer32 2 and its interrupt
  * @see Clock_GetFreq()
  * @brief  Initialize clock to 48 MHz
  */
@@ -71,32 +73,88 @@ uint32_t Clock_GetFreq(void);
 
 
 /**
- * Simple delay function which delays about n milliseconds.
- * It is implemented with a nested for-loop and is very approximate.
+ * Return the time since Clock_Init48MHz() was called.
+ * Timer32 2 counts the 48 MHz bus clock and reloads every
+ * second, so the time is exact whatever the compiler or
+ * the interrupts do.  It counts up monotonically and wraps
+ * every 71.6 minutes, so compare times by subtracting them.
+ * @param none
+ * @return time in us, 0 if Clock_Init48MHz() has not succeeded
+ * @note  Works with interrupts disabled
+ * @brief  Read the microsecond clock
+ */
+uint32_t Clock_Now_us(void);
+
+/**
+ * Busy-wait until the given time.  Interrupts that run
+ * while waiting do not make the delay longer, and a
+ * sequence of waits for evenly spaced deadlines does not
+ * drift.
+ * @param  deadline is a time from Clock_Now_us()
+ * @return none
+ * @brief  Busy-wait until a deadline
+ */
+void Clock_DelayUntil_us(uint32_t deadline);
+
+/**
+ * Sleep (LPM0) with WaitForInterrupt() until the next
+ * interrupt, and add the time asleep to the idle time.
+ * @param  none
+ * @return none
+ * @see Clock_Idle_us()
+ * @brief  Sleep until an interrupt
+ */
+void Clock_Sleep(void);
+
+/**
+ * Return the total time spent in Clock_Sleep().  Divide
+ * by Clock_Now_us() for the fraction of time the processor
+ * was idle.
+ * @param  none
+ * @return idle time in us, wraps like Clock_Now_us()
+ * @brief  Read the idle time
+ */
+uint32_t Clock_Idle_us(void);
+
+/**
+ * Wait until the given time, sleeping whenever an interrupt
+ * is sure to wake the processor before the deadline, and
+ * busy-waiting the rest of the time, so the wake-up is as
+ * exact as a busy-wait.  The wake-up comes from the once a
+ * second Timer32 2 interrupt, or SysTick if its interrupt is
+ * running (for example Scheduler_Init()), so with a 1 ms
+ * SysTick all but the last tick of a long wait is asleep.
+ * @param  deadline is a time from Clock_Now_us()
+ * @return none
+ * @note An interrupt service routine never sleeps, and interrupts
+ * must be enabled for the processor to sleep
+ * @brief  Sleep until a deadline
+ */
+void Clock_SleepUntil_us(uint32_t deadline);
+
+/**
+ * Delay n milliseconds using the microsecond clock,
+ * sleeping when possible with Clock_SleepUntil_us().
+ * Interrupts while waiting do not make the delay longer.
  * @param  n is the number of msec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
- * This implementation is not very accurate.
- * To improve accuracy, you could tune this function
- * by adjusting the constant within the implementation
- * found in the <b>Clock.c</b> file.
- * For a more accurate time delay, you could use the SysTick module.
- * @brief  Software implementation of a busy-wait delay
+ * @note Before Clock_Init48MHz() this falls back to a tuned
+ * loop, which is approximate.
+ * @see Clock_SleepUntil_us()
+ * @brief  Delay in ms
  */
 void Clock_Delay1ms(uint32_t n);
 
 /**
- * Simple delay function which delays about n microseconds.
- * It is implemented with a nested for-loop and is very approximate.
+ * Delay n microseconds using the microsecond clock,
+ * sleeping when possible with Clock_SleepUntil_us().
+ * Interrupts while waiting do not make the delay longer.
  * @param  n is the number of usec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
- * This implementation is not very accurate.
- * To improve accuracy, you could tune this function
- * by adjusting the constant within the implementation
- * found in the <b>Clock.c</b> file.
- * For a more accurate time delay, you could use the SysTick module.
- * @brief  Software implementation of a busy-wait delay
+ * @note Before Clock_Init48MHz() this falls back to a tuned
+ * loop, which is approximate.
+ * @see Clock_SleepUntil_us()
+ * @brief  Delay in us
  */
 void Clock_Delay1us(uint32_t n);
 
@@ -0,0 +1,140 @@
+// Convert.c
+// Runs on MSP432
+// Division-free conversions of 12 MHz timer counts into
+// distance and speed.  Constant divisors become a multiply
+// by a reciprocal and a shift, and the wheel speed uses a
+// normalized reciprocal refined by Newton-Raphson, so the
+// time taken does not depend on the data.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Convert.h"
+
+// ceil(2^32/d): floor(n*RECIP32(d)/2^32) equals n/d for all
+// n < 2^32/(RECIP32(d)*d-2^32), more than 10^7 for the divisors here
+#define RECIP32(d) ((uint32_t)((0x100000000ULL+(d)-1)/(d)))
+#define ECHOMM   RECIP32(CONVERT_ECHOMM)
+#define ECHOIN   RECIP32(CONVERT_ECHOIN)
+
+// 2^47/p at the middle of each of the 32 intervals of a 16-bit
+// p with its top bit set, good to 1.6%; two Newton-Raphson steps
+// bring this to about 2^-24
+#define RECIP(i) ((uint32_t)(0x800000000000ULL/((((i)+32)<<10)+512)))
+static const uint32_t RecipTable[32]={
+  RECIP(0), RECIP(1), RECIP(2), RECIP(3), RECIP(4), RECIP(5), RECIP(6), RECIP(7),
+  RECIP(8), RECIP(9), RECIP(10),RECIP(11),RECIP(12),RECIP(13),RECIP(14),RECIP(15),
+  RECIP(16),RECIP(17),RECIP(18),RECIP(19),RECIP(20),RECIP(21),RECIP(22),RECIP(23),
+  RECIP(24),RECIP(25),RECIP(26),RECIP(27),RECIP(28),RECIP(29),RECIP(30),RECIP(31)
+};
+
+//------------Convert_EchoToMm------------
+// Convert an ultrasonic echo time into distance,
+// the same as counts/CONVERT_ECHOMM.
+// Input: counts echo time (units of 83.33 ns), less than 10^7
+// Output: distance (units mm)
+uint32_t Convert_EchoToMm(uint32_t counts){
+  return ((uint64_t)counts*ECHOMM)>>32;
+}
+
+//------------Convert_EchoToIn------------
+// Convert an ultrasonic echo time into distance,
+// the same as counts/CONVERT_ECHOIN.
+// Input: counts echo time (units of 83.33 ns), less than 10^7
+// Output: distance (units 0.1 in)
+uint32_t Convert_EchoToIn(uint32_t counts){
+  return ((uint64_t)counts*ECHOIN)>>32;
+}
+
+// n/d for n less than 2^23 and d 1 to 65535.  The divisor is
+// shifted so its top bit is set, the reciprocal is looked up
+// and refined twice, and the quotient is corrected by at most one.
+static uint32_t quotient(uint32_t n, uint32_t d){
+  uint32_t s, p, y, q;
+  int64_t e;
+  int32_t r;
+  s = __CLZ(d) - 16;               // 0 to 15
+  p = d<<s;                        // 0x8000 to 0xFFFF
+  y = RecipTable[(p>>10)-32];      // about 2^47/p
+  e = 0x800000000000LL - (int64_t)((uint64_t)p*y);
+  y = y + (int32_t)(((int64_t)y*(e>>15))>>32);
+  e = 0x800000000000LL - (int64_t)((uint64_t)p*y);
+  y = y + (int32_t)(((int64_t)y*(e>>15))>>32);
+  q = ((uint64_t)n*y)>>(47-s);
+  r = n - q*d;                     // remainder, -d to 2*d
+  if(r < 0){
+    q = q - 1;
+  }else if(r >= (int32_t)d){
+    q = q + 1;
+  }
+  return q;
+}
+
+//------------Convert_PeriodToRpm------------
+// Convert a tachometer period into wheel speed,
+// the same as CONVERT_RPM/period, without a divide.
+// Input: period time between tachometer edges (units of 83.33 ns)
+// Output: wheel speed (units rpm), 0 if period is 0
+uint32_t Convert_PeriodToRpm(uint16_t period){
+  if(period == 0){
+    return 0;
+  }
+  return quotient(CONVERT_RPM, period);
+}
+
+//------------Convert_UsToRpm------------
+// Convert a tachometer period in us into wheel speed,
+// the same as CONVERT_USRPM/us, without a divide.  For
+// slow wheels, whose period does not fit the 16-bit capture.
+// Input: us time between tachometer edges (units of us)
+// Output: wheel speed (units rpm), 0 if us is 0
+uint32_t Convert_UsToRpm(uint32_t us){
+  if(us == 0){
+    return 0;
+  }
+  if(us < 65536){
+    return quotient(CONVERT_USRPM, us);
+  }
+  if(us <= CONVERT_USRPM/2){       // 65536 and up is at most 2 rpm
+    return 2;
+  }
+  return (us <= CONVERT_USRPM) ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file      Convert.h
+ * @brief     Division-free conversions of timer counts
+ * @details   Convert 12 MHz timer counts into distance and
+ * speed without a divide instruction, so the conversions take
+ * the same time for every input and are safe to call from an
+ * interrupt service routine.  Constant divisors become a
+ * multiply by a reciprocal computed at compile time and a
+ * shift.  Tachometer periods are converted with a normalized
+ * reciprocal table refined by Newton-Raphson.  The results are
+ * exactly the same as the integer divisions they replace.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef CONVERT_H_
+#define CONVERT_H_
+
+/**
+ * \brief Echo time per mm of distance, 2/(343 m/s) at 12 MHz (units of 83.33 ns)
+ */
+#define CONVERT_ECHOMM  70
+/**
+ * \brief Echo time per 0.1 in of distance, 2/(343 m/s) at 12 MHz (units of 83.33 ns)
+ */
+#define CONVERT_ECHOIN  178
+/**
+ * \brief Wheel rpm times period, 60 s*12 MHz/360 edges per turn
+ */
+#define CONVERT_RPM     2000000
+/**
+ * \brief Wheel rpm times period in us, 60 s*10^6 us/360 edges per turn
+ */
+#define CONVERT_USRPM   166666
+
+/**
+ * Convert an ultrasonic echo time into distance.
+ * The result is the same as counts/CONVERT_ECHOMM.
+ * @param counts echo time (units of 83.33 ns), less than 10^7
+ * @return distance (units mm)
+ * @brief  Convert echo time to mm
+ */
+uint32_t Convert_EchoToMm(uint32_t counts);
+
+/**
+ * Convert an ultrasonic echo time into distance.
+ * The result is the same as counts/CONVERT_ECHOIN.
+ * @param counts echo time (units of 83.33 ns), less than 10^7
+ * @return distance (units 0.1 in)
+ * @brief  Convert echo time to 0.1 in
+ */
+uint32_t Convert_EchoToIn(uint32_t counts);
+
+/**
+ * Convert a tachometer period into wheel speed.
+ * The result is the same as CONVERT_RPM/period.
+ * @param period time between tachometer edges (units of 83.33 ns)
+ * @return wheel speed (units rpm), 0 if period is 0
+ * @brief  Convert tachometer period to rpm
+ */
+uint32_t Convert_PeriodToRpm(uint16_t period);
+
+/**
+ * Convert a tachometer period measured in us into wheel
+ * speed, for periods too long for the 16-bit capture.
+ * The result is the same as CONVERT_USRPM/us.
+ * @param us time between tachometer edges (units of us)
+ * @return wheel speed (units rpm), 0 if us is 0
+ * @brief  Convert tachometer period in us to rpm
+ */
+uint32_t Convert_UsToRpm(uint32_t us);
+
+#endif /* CONVERT_H_ */
@@ -47,17 +47,36 @@ policies, either expressed or implied, of the FreeBSD Project.
 // UCA0RXD (VCP receive) connected to P1.2
 // UCA0TXD (VCP transmit) connected to P1.3
 #include <stdint.h>
+#include "../inc/BaudRate.h"
 #include "../inc/FIFO0.h"
+#include "../inc/Format.h"
 #include "EUSCIA0.h"
 #include "msp.h"
 
 
 //------------EUSCIA0_Init------------
-// Initialize the UART for 115,200 baud rate (assuming 48 MHz bus clock),
+// Initialize the UART for 115,200 baud rate,
 // 8 bit word length, no parity bits, one stop bit
 // Input: none
 // Output: none
 void EUSCIA0_Init(void){
+  EUSCIA0_InitBaud(115200);
+}
+
+//------------EUSCIA0_InitBaud------------
+// Initialize the UART for any baud rate, with the dividers
+// computed from the SMCLK frequency,
+// 8 bit word length, no parity bits, one stop bit
+// Input: baud  baud rate in bits/sec, up to SMCLK/3
+// Output: error of the actual baud rate in ppm, or
+//         BAUDRATE_BAD (port unchanged) if it cannot be generated
+int32_t EUSCIA0_InitBaud(uint32_t baud){
+  uint16_t brw, mctlw;
+  int32_t error;
+  error = BaudRate_Divider(BaudRate_SMCLK(), baud, &brw, &mctlw);
+  if(error == BAUDRATE_BAD){
+    return error;
+  }
   RxFifo0_Init();              // initialize FIFOs
   TxFifo0_Init();
   EUSCI_A0->CTLW0 = 0x0001;         // hold the USCI module in reset mode
@@ -76,9 +95,9 @@ void EUSCIA0_Init(void){
   // bit0=1,       hold logic in reset state while configuring
   EUSCI_A0->CTLW0 = 0x00C1;
   // set the baud rate
-  // N = clock/baud rate = 12,000,000/115,200 = 104.1667
-  EUSCI_A0->BRW = 104;          // UCBR = baud rate = int(N) = 104
-  EUSCI_A0->MCTLW &= ~0xFFF1;   // clear first and second modulation stage bit fields
+  // N = clock/baud rate, e.g., 12,000,000/115,200 = 104.1667 gives
+  EUSCI_A0->BRW = brw;          // UCBR = int(N/16) = 6
+  EUSCI_A0->MCTLW = mctlw;      // UCBRS = 0x20 for frac(N), UCBRF = 8, UCOS16 = 1
 
 // since TxFifo is empty, we initially disarm interrupts on UCTXIFG, but arm it on OutChar
   P1->SEL0 |= 0x0C;
@@ -89,6 +108,7 @@ void EUSCIA0_Init(void){
   EUSCI_A0->CTLW0 &= ~0x0001;   // enable the USCI module
                                 // enable interrupts on receive full
   EUSCI_A0->IE = 0x0001;        // disable interrupts on transmit empty, start, complete
+  return error;
 }
 
 
@@ -103,6 +123,18 @@ char EUSCIA0_InChar(void){
   return(letter);
 }
 
+//------------EUSCIA0_InCharNonBlock------------
+// Get new serial port input without waiting
+// Input: none
+// Output: ASCII code for key typed, 0 if no data
+char EUSCIA0_InCharNonBlock(void){
+  char letter;
+  if(RxFifo0_Get(&letter) == FIFOFAIL){
+    return 0;
+  }
+  return(letter);
+}
+
 //------------EUSCIA0_OutChar------------
 // Output 8-bit to serial port
 // Input: letter is an 8-bit ASCII character to be transferred
@@ -178,70 +210,19 @@ char character;
 // Input: 32-bit number to be transferred
 // Output: none
 // Variable format 1-10 digits with no space before or after
-void EUSCIA0_OutUDec(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    EUSCIA0_OutUDec(n/10);
-    n = n%10;
-  }
-  EUSCIA0_OutChar(n+'0'); /* n is between 0 and 9 */
+void EUSCIA0_OutUDec(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 0);
+  EUSCIA0_OutString(buf);
 }
 
-uint32_t Messageindexc;
-char Messagec[8];
-void static fillmessagec(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    fillmessagec(n/10);
-    n = n%10;
-  }
-  Messagec[Messageindexc] = (n+'0'); /* n is between 0 and 9 */
-  if(Messageindexc<7)Messageindexc++;
-}
-void static fillmessage4b(uint32_t n){
-  if(n>=1000){  // 1000 to 9999
-    Messageindexc = 0;
-  } else if(n>=100){  // 100 to 999
-    Messagec[0] = ' ';
-    Messageindexc = 1;
-  }else if(n>=10){ //
-    Messagec[0] = ' '; /* n is between 10 and 99 */
-    Messagec[1] = ' ';
-    Messageindexc = 2;
-  }else{
-    Messagec[0] = ' '; /* n is between 0 and 9 */
-    Messagec[1] = ' ';
-    Messagec[2] = ' ';
-    Messageindexc = 3;
-  }
-  fillmessagec(n);
-}
-void static fillmessage5b(uint32_t n){
-  if(n>99999)n=99999;
-  if(n>=10000){  // 10000 to 99999
-    Messageindexc = 0;
-  } else if(n>=1000){  // 1000 to 9999
-    Messagec[0] = ' ';
-    Messageindexc = 1;
-  }else if(n>=100){  // 100 to 999
-    Messagec[0] = ' ';
-    Messagec[1] = ' ';
-    Messageindexc = 2;
-  }else if(n>=10){ //
-    Messagec[0] = ' '; /* n is between 10 and 99 */
-    Messagec[1] = ' ';
-    Messagec[2] = ' ';
-    Messageindexc = 3;
-  }else{
-    Messagec[0] = ' '; /* n is between 0 and 9 */
-    Messagec[1] = ' ';
-    Messagec[2] = ' ';
-    Messagec[3] = ' ';
-    Messageindexc = 4;
-  }
-  fillmessagec(n);
+//-----------------------EUSCIA0_OutSDec-----------------------
+// Output a 32-bit number in signed decimal format
+// Input: 32-bit number to be transferred
+// Output: none
+// Variable format 1-11 characters with no space before or after
+void EUSCIA0_OutSDec(int32_t n){char buf[FORMAT_SIZE];
+  Format_SDec(buf, n, 0);
+  EUSCIA0_OutString(buf);
 }
 
 //-----------------------EUSCIA0_OutUDec4-----------------------
@@ -249,15 +230,9 @@ void static fillmessage5b(uint32_t n){
 // Input: 32-bit number to be transferred
 // Output: none
 // Fixed format 4 digits with no space before or after
-void EUSCIA0_OutUDec4(uint32_t n){
-  if(n>9999){
-    EUSCIA0_OutString("****");
-  }else{
-    Messageindexc = 0;
-    fillmessage4b(n);
-    Messagec[Messageindexc] = 0; // terminate
-    EUSCIA0_OutString(Messagec);
-  }
+void EUSCIA0_OutUDec4(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 4);          // "****" if more than 4 digits
+  EUSCIA0_OutString(buf);
 }
 
 //-----------------------EUSCIA0_OutUDec5-----------------------
@@ -265,15 +240,9 @@ void EUSCIA0_OutUDec4(uint32_t n){
 // Input: 32-bit number to be transferred
 // Output: none
 // Fixed format 5 digits with no space before or after
-void EUSCIA0_OutUDec5(uint32_t n){
-  if(n>99999){
-    EUSCIA0_OutString("*****");
-  }else{
-    Messageindexc = 0;
-    fillmessage5b(n);
-    Messagec[Messageindexc] = 0; // terminate
-    EUSCIA0_OutString(Messagec);
-  }
+void EUSCIA0_OutUDec5(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 5);          // "*****" if more than 5 digits
+  EUSCIA0_OutString(buf);
 }
 
 //-----------------------EUSCIA0_OutUFix1-----------------------
@@ -281,10 +250,9 @@ void EUSCIA0_OutUDec5(uint32_t n){
 // Input: 32-bit number to be transferred
 // Output: none
 // fixed format <digit>.<digit> with no space before or after
-void EUSCIA0_OutUFix1(uint32_t n){
-  EUSCIA0_OutUDec(n/10);
-  EUSCIA0_OutChar('.');
-  EUSCIA0_OutUDec(n%10);
+void EUSCIA0_OutUFix1(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UFix(buf, n, 1, 0);
+  EUSCIA0_OutString(buf);
 }
 
 //-----------------------EUSCIA0_OutUFix2-----------------------
@@ -292,12 +260,9 @@ void EUSCIA0_OutUFix1(uint32_t n){
 // Input: 32-bit number to be transferred
 // Output: none
 // fixed format <digit>.<digit><digit> with no space before or after
-void EUSCIA0_OutUFix2(uint32_t n){
-  EUSCIA0_OutUDec(n/100);
-  EUSCIA0_OutChar('.');
-  n = n%100;
-  EUSCIA0_OutUDec(n/10);
-  EUSCIA0_OutUDec(n%10);
+void EUSCIA0_OutUFix2(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UFix(buf, n, 2, 0);
+  EUSCIA0_OutString(buf);
 }
 
 //---------------------EUSCIA0_InUHex----------------------------------------
@@ -83,15 +83,28 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 /**
  * @details   Initialize EUSCI_A0 for UART operation
- * @details   115,200 baud rate (assuming 12 MHz SMCLK clock),
+ * @details   115,200 baud rate,
  * @details   8 bit word length, no parity bits, one stop bit
  * @param  none
  * @return none
- * @note   assumes 48 MHz bus and 12 MHz SMCLK
+ * @see EUSCIA0_InitBaud()
  * @brief  Initialize EUSCI A0, interrupt-driven
  */
 void EUSCIA0_Init(void);
 
+/**
+ * @details   Initialize EUSCI_A0 for UART operation at any baud rate
+ * @details   The dividers and modulation pattern are computed from
+ * @details   the SMCLK frequency, 8 bit word length, no parity bits, one stop bit
+ * @param  baud is the baud rate in bits/sec, up to SMCLK/3
+ * @return error of the actual baud rate in parts per million,
+ * or BAUDRATE_BAD if it cannot be generated and the port is unchanged
+ * @note   with the 12 MHz SMCLK from Clock_Init48MHz(), 1, 1.5, 2 and
+ * 3 Mbaud have no error
+ * @brief  Initialize EUSCI A0 at a baud rate, interrupt-driven
+ */
+int32_t EUSCIA0_InitBaud(uint32_t baud);
+
 
 /**
  * @details   Receive a character from EUSCI_A0 UART
@@ -105,6 +118,18 @@ void EUSCIA0_Init(void);
 char EUSCIA0_InChar(void);
 
 
+/**
+ * @details   Receive a character from EUSCI_A0 UART
+ * @details   Interrupt synchronization,
+ * @details   non-blocking, returns 0 if the RxFifo0 FIFO is empty
+ * @param  none
+ * @return ASCII code for key typed, 0 if no data
+ * @note   EUSCIA0_Init must be called once prior
+ * @brief  Receive byte into MSP432 without waiting
+ */
+char EUSCIA0_InCharNonBlock(void);
+
+
 /**
  * @details   Transmit a character to EUSCI_A0 UART
  * @details   Interrupt synchronization,
@@ -152,6 +177,16 @@ uint32_t EUSCIA0_InUDec(void);
  */
 void EUSCIA0_OutUDec(uint32_t n);
 
+/**
+ * @details   Transmit a number as ASCII characters in signed decimal format
+ * @details   Variable format 1-11 characters with no space before or after
+ * @param  n is a signed 32-bit number to be transferred
+ * @return none
+ * @note   EUSCIA0_Init must be called once prior
+ * @brief  Transmit a signed number out of MSP432
+ */
+void EUSCIA0_OutSDec(int32_t n);
+
 
 /**
  * @details   Receive an unsigned number from EUSCI_A0 UART
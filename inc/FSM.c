@@ -0,0 +1,101 @@
+// FSM.c
+// Runs on MSP432
+// Table-driven Moore finite state machine, stepped at a
+// fixed rate with a classified input.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/FSM.h"
+
+static const struct FSMState *State;  // current state
+static uint32_t Period;               // ms between steps
+static uint32_t Time;                 // ms of dwell left
+
+// dwell time of a state in ms
+static uint32_t dwell(const struct FSMState *state){
+  if((state->dwell == 0) || (*state->dwell <= 0)){
+    return 0;
+  }
+  return *state->dwell;
+}
+
+//------------FSM_Init------------
+// Start the state machine in a state.
+// Input: start   first state
+//        period  ms between calls to FSM_Step()
+// Output: none
+void FSM_Init(const struct FSMState *start, uint32_t period){
+  State = start;
+  Period = period;
+  Time = dwell(start);
+}
+
+//------------FSM_Step------------
+// Advance one period: count down the dwell time, then
+// look up the next state from the input.
+// Input: input  class 0 to FSM_INPUTS-1
+// Output: 1 if a new state was entered, 0 if not
+int FSM_Step(uint32_t input){
+  const struct FSMState *next;
+  if(Time > Period){
+    Time = Time - Period;
+    return 0;
+  }
+  Time = 0;
+  if(input >= FSM_INPUTS){
+    return 0;
+  }
+  next = State->next[input];
+  if((next == 0) || (next == State)){
+    return 0;
+  }
+  State = next;
+  Time = dwell(next);
+  return 1;
+}
+
+//------------FSM_State------------
+// Return the current state.
+// Input: none
+// Output: current state
+const struct FSMState *FSM_State(void){
+  return State;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file      FSM.h
+ * @brief     Table-driven Moore finite state machine
+ * @details   A behaviour is a const array of states in flash.
+ * Each state has an output, an optional mark reported once on
+ * entry, a dwell time, and the next state for each input class.
+ * The application classifies its sensors into a small number,
+ * calls FSM_Step() with it at a fixed rate, and applies the
+ * output of FSM_State().  A transition is one table lookup, and
+ * the behaviour is changed by editing the table, not the code.<br>
+ * Dwell times are pointers to int32_t so they can be constants
+ * or parameters tuned at run time.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef FSM_H_
+#define FSM_H_
+
+/**
+ * \brief Maximum number of input classes
+ */
+#define FSM_INPUTS 8
+
+/**
+ * \brief One state of a Moore machine, stored in flash
+ */
+struct FSMState{
+  uint8_t out;            /**< output, e.g., a motor command, applied while in the state */
+  uint8_t mark;           /**< reported once on entry, 0 for none */
+  const int32_t *dwell;   /**< ms to stay before the input is looked at, 0 for none */
+  const struct FSMState *next[FSM_INPUTS]; /**< next state for each input class, 0 to stay */
+};
+
+/**
+ * Start the state machine in a state.  Its dwell time
+ * begins now.
+ * @param start is the first state
+ * @param period is the time between calls to FSM_Step() in ms
+ * @return none
+ * @brief  Initialize the state machine
+ */
+void FSM_Init(const struct FSMState *start, uint32_t period);
+
+/**
+ * Advance the state machine by one period.  Until the dwell
+ * time of the state has passed the input is ignored, then the
+ * next state is looked up from the input.
+ * @param input is the input class, 0 to FSM_INPUTS-1
+ * @return 1 if a new state was entered, 0 if not
+ * @note   Call every period ms, e.g., from a Scheduler task
+ * @brief  Step the state machine
+ */
+int FSM_Step(uint32_t input);
+
+/**
+ * Return the current state, whose out field the application
+ * applies.
+ * @param  none
+ * @return current state
+ * @brief  Get the current state
+ */
+const struct FSMState *FSM_State(void);
+
+#endif /* FSM_H_ */
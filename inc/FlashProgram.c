@@ -43,6 +43,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "FlashProgram.h"
+#include "CortexM.h"
 
 #define FLASH_BANK0_MIN     0x00000000  // Flash Bank0 minimum address
 #define FLASH_BANK0_MAX     0x0001FFFF  // Flash Bank0 maximum address
@@ -402,44 +403,59 @@ int Flash_WriteArray(uint32_t *source, uint32_t addr, uint16_t count){
 //------------Flash_FastWrite------------
 // Write an array of 32-bit data to flash starting at given address.
 // This is twice as fast as Flash_WriteArray(), but the address has
-// to be 16-byte aligned, and the count has to be <= 16.  Parameter
-// 'addr' must be in flash Bank 1, and this function must be in
-// flash Bank 0.
+// to be 16-byte aligned, and the count has to be <= 16.  This
+// function runs from SRAM, so 'addr' may be in either flash bank,
+// but all 'count' words must be in the same bank.
 // Input: source pointer to array of 32-bit data
 //        addr   16-byte aligned flash memory address to start writing
 //        count  number of 32-bit writes (<=16)
 // Output: number of successful writes; return value == min(count, 16) if completely successful
 // Note: at 48 MHz, it takes 97 usec to write 10 words
-// Note: This function is not interrupt safe.
+// Note: Interrupts are disabled while this runs, because the
+//       read mode of the bank being written is changed during the
+//       verify steps and no code may be fetched from that bank.
+#pragma CODE_SECTION(Flash_FastWrite, ".TI.ramfunc")
 int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
   volatile uint32_t *FLCTL_PRGBRST_DATAn_x = (volatile uint32_t *)0x40011060; /* Program Burst Data0 Register0 */
+  volatile uint32_t *rdctl, *weprot;
   uint32_t lockStatus, lockMask, numPrgPulses, existingData, actualData, failBits[16], updatedData[16];
+  uint32_t bankMin, waitStates;
   int writes = 0, i;
-  if((IsInBank0(addr)) || (IsInBank1((int)&Flash_FastWrite))){
-    // This function and the flash to be written are in the same bank.
-    // Because we cannot change the read mode of the flash that contains
-    // the currently running code, we need to either copy this function
-    // to RAM or use one of the library functions in ROM.
-                 // to do later: fix this
-    return 0;
-  }
+  long sr;
   if(count > 16){
     // Write a maximum of 16 32-bit words.
     count = 16;
   }
-  if(MassWriteAddrValid(addr, count)){
+  if(count == 0){
+    return 0;
+  }
+  // Select the control registers of the bank to be written.
+  if(IsInBank1(addr)){
+    rdctl = &FLCTL_BANK1_RDCTL;
+    weprot = &FLCTL_BANK1_MAIN_WEPROT;
+    bankMin = FLASH_BANK1_MIN;
+  } else{
+    rdctl = &FLCTL_BANK0_RDCTL;
+    weprot = &FLCTL_BANK0_MAIN_WEPROT;
+    bankMin = FLASH_BANK0_MIN;
+  }
+  if(MassWriteAddrValid(addr, count) && (IsInBank1(addr) == IsInBank1(addr + 4*count - 1))){
+    // Nothing may run from flash until the read mode is restored.
+    sr = StartCritical();
+    // Remember the wait states, which depend on the clock frequency.
+    waitStates = (*rdctl)&FLCTL_BANK1_RDCTL_WAIT_M;
     // Clear pending PRGB, PRG_ERR, AVPST, and AVPRE interrupt flags.
     FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
     // Keep track of the number of programming pulses.
     numPrgPulses = 0;
     // Clear any past errors and set status back to "idle".
     FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
-    // Unlock the block in Flash Main Memory Bank 1.
-    lockMask = 1<<((addr - FLASH_BANK1_MIN)>>12);   // 0x00000001 to 0x80000000
+    // Unlock the block in Flash Main Memory.
+    lockMask = 1<<((addr - bankMin)>>12);           // 0x00000001 to 0x80000000
     // Make sure that the last memory location is also unlocked.
-    lockMask |= 1<<((addr - FLASH_BANK1_MIN + 4*count - 1)>>12);
-    lockStatus = FLCTL_BANK1_MAIN_WEPROT&lockMask;  // save previous value
-    FLCTL_BANK1_MAIN_WEPROT = (FLCTL_BANK1_MAIN_WEPROT&~lockMask);
+    lockMask |= 1<<((addr - bankMin + 4*count - 1)>>12);
+    lockStatus = (*weprot)&lockMask;                // save previous value
+    *weprot = ((*weprot)&~lockMask);
     // Write data to be programmed into the burst data registers.  (FLCTL_PRGBRST_DATAn_x)
     for(i=0; i<count; i=i+1){
       FLCTL_PRGBRST_DATAn_x[i] = source[i];
@@ -487,8 +503,9 @@ int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
       FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
       // Clear any past errors and set status back to "idle".
       FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
-      // Recall lock status of the block in Flash Main Memory Bank 1.
-      FLCTL_BANK1_MAIN_WEPROT = FLCTL_BANK1_MAIN_WEPROT|lockStatus;
+      // Recall lock status of the block in Flash Main Memory.
+      *weprot = (*weprot)|lockStatus;
+      EndCritical(sr);
       // It is possible that some data was correctly written if the mass write
       // straddles a reserved and a not reserved block.  This error response may
       // need to be changed depending on how the higher-level program intends to
@@ -508,16 +525,17 @@ int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
           FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
           // Clear any past errors and set status back to "idle".
           FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
-          // Recall lock status of the block in Flash Main Memory Bank 1.
-          FLCTL_BANK1_MAIN_WEPROT = FLCTL_BANK1_MAIN_WEPROT|lockStatus;
+          // Recall lock status of the block in Flash Main Memory.
+          *weprot = (*weprot)|lockStatus;
+          EndCritical(sr);
           return writes;
         }
         // At least one bit was already 0 before programming started.
-        // The flash to be written is in Bank 1.
+        // The flash to be written is in the bank selected above.
         // Configure for 5 wait states (minimum for 48 MHz operation) and for read mode of Program Verify.
-        FLCTL_BANK1_RDCTL = FLCTL_BANK1_RDCTL_WAIT_5|FLCTL_BANK1_RDCTL_RD_MODE_3;
+        *rdctl = FLCTL_BANK1_RDCTL_WAIT_5|FLCTL_BANK1_RDCTL_RD_MODE_3;
         // Wait for the read mode change to be confirmed.
-        while((FLCTL_BANK1_RDCTL&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_3){};
+        while(((*rdctl)&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_3){};
         for(i=0; i<count; i=i+1){
           existingData = *(volatile uint32_t *)(addr + 4*i);
           failBits[i] = ~(existingData|FLCTL_PRGBRST_DATAn_x[i]);
@@ -525,11 +543,11 @@ int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
           updatedData[i] = FLCTL_PRGBRST_DATAn_x[i]|failBits[i];
         }
         // Configure for read mode of Normal Read.
-        FLCTL_BANK1_RDCTL = (FLCTL_BANK1_RDCTL&~FLCTL_BANK1_RDCTL_RD_MODE_M)|FLCTL_BANK1_RDCTL_RD_MODE_0;
+        *rdctl = ((*rdctl)&~FLCTL_BANK1_RDCTL_RD_MODE_M)|FLCTL_BANK1_RDCTL_RD_MODE_0;
         // Wait for the read mode change to be confirmed.
-        while((FLCTL_BANK1_RDCTL&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_0){};
-        // Configure for 2 wait states (minimum for 48 MHz operation).
-        FLCTL_BANK1_RDCTL = (FLCTL_BANK1_RDCTL&~FLCTL_BANK1_RDCTL_WAIT_M)|FLCTL_BANK1_RDCTL_WAIT_2;
+        while(((*rdctl)&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_0){};
+        // Restore the wait states used before this function was called.
+        *rdctl = ((*rdctl)&~FLCTL_BANK1_RDCTL_WAIT_M)|waitStates;
         // Clear all error flags in FLCTL_CLRIFG and FLCTL_PRGBRST_CTLSTAT registers.
         FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
         FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
@@ -569,27 +587,28 @@ int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
           FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
           // Clear any past errors and set status back to "idle".
           FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
-          // Recall lock status of the block in Flash Main Memory Bank 1.
-          FLCTL_BANK1_MAIN_WEPROT = FLCTL_BANK1_MAIN_WEPROT|lockStatus;
+          // Recall lock status of the block in Flash Main Memory.
+          *weprot = (*weprot)|lockStatus;
+          EndCritical(sr);
           return writes;
         }
         // At least one bit was still 1 after programming finished.
-        // The flash to be written is in Bank 1.
+        // The flash to be written is in the bank selected above.
         // Configure for 5 wait states (minimum for 48 MHz operation) and for read mode of Program Verify.
-        FLCTL_BANK1_RDCTL = FLCTL_BANK1_RDCTL_WAIT_5|FLCTL_BANK1_RDCTL_RD_MODE_3;
+        *rdctl = FLCTL_BANK1_RDCTL_WAIT_5|FLCTL_BANK1_RDCTL_RD_MODE_3;
         // Wait for the read mode change to be confirmed.
-        while((FLCTL_BANK1_RDCTL&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_3){};
+        while(((*rdctl)&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_3){};
         for(i=0; i<count; i=i+1){
           actualData = *(volatile uint32_t *)(addr + 4*i);
           failBits[i] = (~FLCTL_PRGBRST_DATAn_x[i])&actualData;
           updatedData[i] = ~failBits[i];            // see Page 383 of MSP432 Datasheet
         }
         // Configure for read mode of Normal Read.
-        FLCTL_BANK1_RDCTL = (FLCTL_BANK1_RDCTL&~FLCTL_BANK1_RDCTL_RD_MODE_M)|FLCTL_BANK1_RDCTL_RD_MODE_0;
+        *rdctl = ((*rdctl)&~FLCTL_BANK1_RDCTL_RD_MODE_M)|FLCTL_BANK1_RDCTL_RD_MODE_0;
         // Wait for the read mode change to be confirmed.
-        while((FLCTL_BANK1_RDCTL&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_0){};
-        // Configure for 2 wait states (minimum for 48 MHz operation).
-        FLCTL_BANK1_RDCTL = (FLCTL_BANK1_RDCTL&~FLCTL_BANK1_RDCTL_WAIT_M)|FLCTL_BANK1_RDCTL_WAIT_2;
+        while(((*rdctl)&FLCTL_BANK1_RDCTL_RD_MODE_STATUS_M) != FLCTL_BANK1_RDCTL_RD_MODE_STATUS_0){};
+        // Restore the wait states used before this function was called.
+        *rdctl = ((*rdctl)&~FLCTL_BANK1_RDCTL_WAIT_M)|waitStates;
         // Clear all error flags in FLCTL_CLRIFG and FLCTL_PRGBRST_CTLSTAT registers.
         FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
         FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
@@ -626,8 +645,65 @@ int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count){
     FLCTL_CLRIFG = (FLCTL_CLRIFG_PRG_ERR|FLCTL_CLRIFG_PRGB|FLCTL_CLRIFG_AVPST|FLCTL_CLRIFG_AVPRE);
     // Clear any past errors and set status back to "idle".
     FLCTL_PRGBRST_CTLSTAT |= FLCTL_PRGBRST_CTLSTAT_CLR_STAT;
-    // Recall lock status of the block in Flash Main Memory Bank 1.
-    FLCTL_BANK1_MAIN_WEPROT = FLCTL_BANK1_MAIN_WEPROT|lockStatus;
+    // Recall lock status of the block in Flash Main Memory.
+    *weprot = (*weprot)|lockStatus;
+    EndCritical(sr);
+  }
+  return writes;
+}
+
+//------------Flash_WriteBulk------------
+// Write an array of 32-bit data of any length to flash starting
+// at any 4-byte aligned address in either bank, using burst
+// programming.  The array is split into 128-bit aligned bursts
+// of up to 16 words.  A partial 128-bit line at either end is
+// written as a full burst with the unused lanes set to
+// 0xFFFFFFFF, which leaves those flash words unchanged.
+// Input: source pointer to array of 32-bit data
+//        addr   4-byte aligned flash memory address to start writing
+//        count  number of 32-bit writes
+// Output: number of successful writes; return value == count if completely successful
+// Note: The words written must already be erased, like Flash_FastWrite().
+int Flash_WriteBulk(uint32_t *source, uint32_t addr, uint16_t count){
+  uint32_t line[4], lane, n, i;
+  int writes = 0;
+  if(WriteAddrValid(addr) == 0){
+    return 0;
+  }
+  while(count > 0){
+    lane = (addr&0x0F)>>2;                          // word position within 128-bit line
+    if((lane != 0) || (count < 4)){
+      // partial line at either end: pad and burst the whole line
+      n = 4 - lane;
+      if(n > count){
+        n = count;
+      }
+      for(i=0; i<4; i=i+1){
+        line[i] = 0xFFFFFFFF;
+      }
+      for(i=0; i<n; i=i+1){
+        line[lane+i] = source[i];
+      }
+      if(Flash_FastWrite(line, addr&~0x0F, 4) != 4){
+        return writes;
+      }
+    } else{
+      // whole lines, up to four per burst, never crossing into the other bank
+      n = count&~0x03;
+      if(n > 16){
+        n = 16;
+      }
+      if((addr <= FLASH_BANK0_MAX) && ((addr + 4*n - 1) > FLASH_BANK0_MAX)){
+        n = (FLASH_BANK0_MAX + 1 - addr)/4;
+      }
+      if(Flash_FastWrite(source, addr, n) != n){
+        return writes;
+      }
+    }
+    source = source + n;
+    addr = addr + 4*n;
+    count = count - n;
+    writes = writes + n;
   }
   return writes;
 }
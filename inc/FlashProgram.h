@@ -120,12 +120,29 @@ int Flash_WriteArray(uint32_t *source, uint32_t addr, uint16_t count);
  * @param   count  number of 32-bit writes
  * @return  Result number of successful writes; return value == min(count, 16) if completely successful
  * @note    At 48 MHz, it takes 114 usec to write 16 words
- * @note    This function is not interrupt safe.
- * @warning Parameter 'addr' must be in flash Bank 1, the function must be in bank 0
+ * @note    Runs from SRAM with interrupts disabled, so 'addr' may be in either bank.
+ * @warning All 'count' words must be in the same flash bank
  * @brief   Write an array to flash
  */
 int Flash_FastWrite(uint32_t *source, uint32_t addr, uint16_t count);
 
+/**
+ * Write an array of 32-bit data of any length to flash starting
+ * at any 4-byte aligned address, using burst programming.
+ * The array is split into aligned 128-bit bursts of up to 16
+ * words; a partial line at either end is padded with 0xFFFFFFFF,
+ * which leaves those flash words unchanged.
+ *
+ * @param   source pointer to array of 32-bit data
+ * @param   addr 4-byte aligned flash memory address to start writing
+ * @param   count  number of 32-bit writes
+ * @return  Result number of successful writes; return value == count if completely successful
+ * @note    Interrupts are disabled during each burst.
+ * @see     Flash_FastWrite()
+ * @brief   Write an array to flash at burst speed
+ */
+int Flash_WriteBulk(uint32_t *source, uint32_t addr, uint16_t count);
+
 
 /**
  * Erase 4 KB block of flash
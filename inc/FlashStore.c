@@ -0,0 +1,375 @@
+// FlashStore.c
+// Runs on MSP432
+// Wear-levelled, log-structured key/value store in flash
+// Bank 1.  New values are appended to a log instead of
+// erasing and rewriting a sector, each record is protected
+// by a CRC-32, and the newest value of every key is found
+// through a RAM index built once at startup.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+// Flash layout, FLASHSTORE_SECTORS sectors of 4 KB each
+// Sector header (4 words)
+//   word 0  MAGIC, or 0xFFFFFFFF if the sector is blank
+//   word 1  number of times this sector has been erased
+//   word 2  sequence number, 0xFFFFFFFF while the sector is a spare
+//   word 3  reserved
+// Records, packed after the header until the first 0xFFFFFFFF word
+//   word 0      0x5A in bits 31-24, key in bits 23-16, length in bytes in bits 15-0
+//   word 1..n   data, little endian, last word padded with 0xFF
+//   word n+1    CRC-32 of words 0..n
+// The sector with the largest sequence number is the head of
+// the log.  A record with a bad CRC was cut short by a reset
+// and is skipped; its space is not reused.  Records are
+// programmed with Flash_WriteBulk(), so one burst may hold the
+// header and the CRC; the CRC still rejects a partial record.
+
+#include <stdint.h>
+#include "../inc/CortexM.h"
+#include "../inc/FlashProgram.h"
+#include "../inc/FlashStore.h"
+
+#define SECTORSIZE  4096
+#define MAGIC       0x54534C46          // "FLST"
+#define BLANK       0xFFFFFFFF          // value of erased flash
+#define TAG         0x5A                // bits 31-24 of a record header
+#define NONE        FLASHSTORE_SECTORS  // no sector
+#define HEADERSIZE  16                  // bytes in sector header
+#define SECTOR(s)   (FLASHSTORE_BASE + SECTORSIZE*(s))
+#define WORD(addr)  (*(const volatile uint32_t *)(addr))
+#define RECWORDS(len) (((len) + 3)/4 + 2) // header, data, and CRC
+
+static uint32_t Index[FLASHSTORE_KEYS]; // address of newest record, 0 if none
+static uint32_t Head = NONE;            // sector holding the end of the log
+static uint32_t HeadSeq;                // sequence number of Head
+static uint32_t WritePtr;               // next free address in Head
+static uint32_t Pending;                // bit s set if sector s can be erased
+static uint32_t Buffer[RECWORDS(FLASHSTORE_MAXLEN)];
+
+// CRC-32 (polynomial 0xEDB88320), one nibble at a time
+static const uint32_t CRCTable[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+  0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+  0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+static uint32_t crc32(const volatile uint32_t *pt, uint32_t count){
+  uint32_t crc = 0xFFFFFFFF, data, i;
+  while(count){
+    data = *pt;
+    for(i=0; i<8; i=i+1){
+      crc = (crc>>4)^CRCTable[(crc^data)&0x0F];
+      data = data>>4;
+    }
+    pt = pt + 1;
+    count = count - 1;
+  }
+  return ~crc;
+}
+
+// a spare sector has been erased and is ready to become the head
+static int isspare(uint32_t s){
+  return ((WORD(SECTOR(s)) == MAGIC) && (WORD(SECTOR(s)+8) == BLANK));
+}
+// a used sector holds part of the log
+static int isused(uint32_t s){
+  return ((WORD(SECTOR(s)) == MAGIC) && (WORD(SECTOR(s)+8) != BLANK));
+}
+// return 1 if the index points to any record in sector s
+static int haslive(uint32_t s){
+  uint32_t key;
+  for(key=0; key<FLASHSTORE_KEYS; key=key+1){
+    if((Index[key] >= SECTOR(s)) && (Index[key] < SECTOR(s+1))){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Walk the records of sector s, pointing the index at each
+// valid one.  Return the address just past the last record,
+// or the end of the sector if the log there is damaged.
+static uint32_t scansector(uint32_t s){
+  uint32_t addr = SECTOR(s) + HEADERSIZE, header, len, key, words;
+  while(addr < SECTOR(s+1)){
+    header = WORD(addr);
+    if(header == BLANK){
+      return addr;                      // end of the log
+    }
+    len = header&0xFFFF;
+    key = (header>>16)&0xFF;
+    words = RECWORDS(len);
+    if(((header>>24) != TAG) || (len > FLASHSTORE_MAXLEN) || ((addr + 4*words) > SECTOR(s+1))){
+      return SECTOR(s+1);               // damaged; close this sector
+    }
+    if((key < FLASHSTORE_KEYS) &&
+       (WORD(addr + 4*(words-1)) == crc32((const volatile uint32_t *)addr, words-1))){
+      Index[key] = addr;
+    }
+    addr = addr + 4*words;
+  }
+  return SECTOR(s+1);
+}
+
+// return 1 if a spare or a sector waiting to be erased is left
+static int inreserve(void){
+  uint32_t s;
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if(isspare(s) || (Pending&(1<<s))){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Copy the live records of the oldest sector other than the
+// head forward to the head, and schedule it to be erased.
+static int copyforward(void){
+  uint32_t s, oldest = NONE, key, words;
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if((s != Head) && isused(s) && ((oldest == NONE) || (WORD(SECTOR(s)+8) < WORD(SECTOR(oldest)+8)))){
+      oldest = s;
+    }
+  }
+  if(oldest == NONE){
+    return NOERROR;
+  }
+  for(key=0; key<FLASHSTORE_KEYS; key=key+1){
+    if((Index[key] >= SECTOR(oldest)) && (Index[key] < SECTOR(oldest+1))){
+      words = RECWORDS(WORD(Index[key])&0xFFFF);
+      if((WritePtr + 4*words) > SECTOR(Head+1)){
+        return ERROR;                   // the head is full
+      }
+      for(s=0; s<words; s=s+1){         // copy through RAM
+        Buffer[s] = WORD(Index[key] + 4*s);
+      }
+      if(Flash_WriteBulk(Buffer, WritePtr, words) != words){
+        return ERROR;
+      }
+      Index[key] = WritePtr;
+      WritePtr = WritePtr + 4*words;
+    }
+  }
+  Pending |= 1<<oldest;
+  return NOERROR;
+}
+
+// Make the spare sector with the fewest erases the new head.
+// If that used up the last spare, copy the live records of
+// the oldest sector forward and schedule it to be erased.
+static int opensector(void){
+  uint32_t s, best = NONE, seq;
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if(isspare(s) && ((best == NONE) || (WORD(SECTOR(s)+4) < WORD(SECTOR(best)+4)))){
+      best = s;
+    }
+  }
+  if(best == NONE){
+    if(FlashStore_Background() == 0){
+      return ERROR;                     // nothing could be erased
+    }
+    return opensector();
+  }
+  seq = (Head == NONE) ? 0 : (HeadSeq + 1);
+  if(Flash_WriteBulk(&seq, SECTOR(best)+8, 1) != 1){
+    return ERROR;
+  }
+  Head = best;
+  HeadSeq = seq;
+  WritePtr = SECTOR(best) + HEADERSIZE;
+  if(inreserve()){
+    return NOERROR;                     // a sector is still in reserve
+  }
+  return copyforward();
+}
+
+//------------FlashStore_Init------------
+// Scan the log sectors and build the RAM index of the
+// newest valid record for each key.  Blank sectors get a
+// header so they can be used as spares; sectors that are
+// damaged or hold no live records are scheduled for erase.
+// If a reset cut short a copy forward, no sector is left in
+// reserve, so the copy of the oldest sector is done again.
+// Input: none
+// Output: 'NOERROR' if successful, 'ERROR' if fail
+int FlashStore_Init(void){
+  uint32_t s, next, key, scanned = 0, header[2];
+  long sr;
+  sr = StartCritical();
+  Head = NONE;
+  Pending = 0;
+  for(key=0; key<FLASHSTORE_KEYS; key=key+1){
+    Index[key] = 0;
+  }
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if((WORD(SECTOR(s)) == BLANK) && (WORD(SECTOR(s)+4) == BLANK) && (WORD(SECTOR(s)+8) == BLANK)){
+      header[0] = MAGIC;                // never used
+      header[1] = 0;                    // no erases yet
+      if(Flash_WriteBulk(header, SECTOR(s), 2) != 2){
+        EndCritical(sr);
+        return ERROR;
+      }
+    } else if(WORD(SECTOR(s)) != MAGIC){
+      Pending |= 1<<s;                  // damaged header
+    }
+  }
+  // replay the used sectors from oldest to newest
+  do{
+    next = NONE;
+    for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+      if(isused(s) && ((scanned&(1<<s)) == 0) &&
+         ((next == NONE) || (WORD(SECTOR(s)+8) < WORD(SECTOR(next)+8)))){
+        next = s;
+      }
+    }
+    if(next != NONE){
+      WritePtr = scansector(next);
+      Head = next;
+      HeadSeq = WORD(SECTOR(next)+8);
+      scanned |= 1<<next;
+    }
+  }while(next != NONE);
+  // everything in these sectors was copied forward before a reset
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if(isused(s) && (s != Head) && (haslive(s) == 0)){
+      Pending |= 1<<s;
+    }
+  }
+  if((Head != NONE) && (inreserve() == 0) && (copyforward() != NOERROR)){
+    EndCritical(sr);
+    return ERROR;
+  }
+  EndCritical(sr);
+  return NOERROR;
+}
+
+//------------FlashStore_Write------------
+// Append a new value for a key to the log and point the
+// index at it.  A new head sector is opened if this record
+// does not fit in the current one.
+// Input: key  record key (0 to FLASHSTORE_KEYS-1)
+//        data pointer to the bytes to save
+//        len  number of bytes (0 to FLASHSTORE_MAXLEN)
+// Output: 'NOERROR' if successful, 'ERROR' if fail
+int FlashStore_Write(uint8_t key, const void *data, uint16_t len){
+  const uint8_t *src = (const uint8_t *)data;
+  uint8_t *dst;
+  uint32_t words = RECWORDS(len), i;
+  long sr;
+  if((key >= FLASHSTORE_KEYS) || (len > FLASHSTORE_MAXLEN)){
+    return ERROR;                       // bad input
+  }
+  sr = StartCritical();
+  if((Head == NONE) || ((WritePtr + 4*words) > SECTOR(Head+1))){
+    if((opensector() != NOERROR) || ((WritePtr + 4*words) > SECTOR(Head+1))){
+      EndCritical(sr);
+      return ERROR;                     // live records copied forward fill the new head
+    }
+  }
+  // build the record in RAM: header, data, CRC
+  Buffer[0] = (TAG<<24)|(key<<16)|len;
+  for(i=1; i<(words-1); i=i+1){
+    Buffer[i] = BLANK;
+  }
+  dst = (uint8_t *)&Buffer[1];
+  for(i=0; i<len; i=i+1){
+    dst[i] = src[i];
+  }
+  Buffer[words-1] = crc32(Buffer, words-1);
+  if(Flash_WriteBulk(Buffer, WritePtr, words) != words){
+    WritePtr = WritePtr + 4*words;      // do not reuse a damaged record
+    EndCritical(sr);
+    return ERROR;
+  }
+  Index[key] = WritePtr;
+  WritePtr = WritePtr + 4*words;
+  EndCritical(sr);
+  return NOERROR;
+}
+
+//------------FlashStore_Read------------
+// Copy the newest value of a key out of flash.
+// Input: key  record key (0 to FLASHSTORE_KEYS-1)
+//        data pointer to buffer to hold the value
+//        max  size of the buffer in bytes
+// Output: length of the stored value in bytes, -1 if not found
+int FlashStore_Read(uint8_t key, void *data, uint16_t max){
+  const volatile uint8_t *src;
+  uint8_t *dst = (uint8_t *)data;
+  uint32_t len, i;
+  if((key >= FLASHSTORE_KEYS) || (Index[key] == 0)){
+    return -1;
+  }
+  len = WORD(Index[key])&0xFFFF;
+  src = (const volatile uint8_t *)(Index[key] + 4);
+  for(i=0; (i<len) && (i<max); i=i+1){
+    dst[i] = src[i];
+  }
+  return len;
+}
+
+//------------FlashStore_Background------------
+// Erase one sector recycled by FlashStore_Write() and give
+// it a new header with its erase count, so it becomes a
+// spare.  Call this while the robot is idle.
+// Input: none
+// Output: 1 if a sector was erased, 0 if nothing to do or fail
+int FlashStore_Background(void){
+  uint32_t s, header[2];
+  long sr;
+  for(s=0; s<FLASHSTORE_SECTORS; s=s+1){
+    if(Pending&(1<<s)){
+      header[0] = MAGIC;
+      header[1] = 1;
+      if((WORD(SECTOR(s)) == MAGIC) && (WORD(SECTOR(s)+4) != BLANK)){
+        header[1] = WORD(SECTOR(s)+4) + 1;
+      }
+      sr = StartCritical();
+      Pending &= ~(1<<s);
+      if((Flash_Erase(SECTOR(s)) != NOERROR) || (Flash_WriteBulk(header, SECTOR(s), 2) != 2)){
+        EndCritical(sr);
+        return 0;
+      }
+      EndCritical(sr);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file      FlashStore.h
+ * @brief     Wear-levelled, log-structured key/value store in flash Bank 1
+ * @details   Keeps small records (learned maze path, sensor
+ * thresholds, controller gains) across power cycles without
+ * erasing and rewriting a 4 KB sector for every save.<br>
+ * 1) Records are appended to a log that spans FLASHSTORE_SECTORS
+ *    4 KB sectors starting at FLASHSTORE_BASE in Bank 1<br>
+ * 2) Each record is a header word, the data, and a CRC-32,
+ *    so a record cut short by a reset is ignored<br>
+ * 3) FlashStore_Init() scans the log once and builds a RAM
+ *    index of the newest valid record for each key<br>
+ * 4) When the head sector fills, the log moves to the spare
+ *    sector with the fewest erases, the live records of the
+ *    oldest sector are copied forward, and that sector is
+ *    erased later by FlashStore_Background()<br>
+ * Saving a 49-byte path is four bursts of Flash_WriteBulk(), well under 1 ms.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef FLASHSTORE_H_
+#define FLASHSTORE_H_
+
+/**
+ * \brief First address of the store, must be 4 KB aligned in Bank 1
+ */
+#define FLASHSTORE_BASE    0x0003E000
+/**
+ * \brief Number of 4 KB sectors used by the store (at least 2)
+ */
+#define FLASHSTORE_SECTORS 2
+/**
+ * \brief Number of keys, valid keys are 0 to FLASHSTORE_KEYS-1
+ */
+#define FLASHSTORE_KEYS    16
+/**
+ * \brief Largest record in bytes
+ * @note  FLASHSTORE_KEYS records of this size must fit in one sector
+ */
+#define FLASHSTORE_MAXLEN  128
+
+/**
+ * \brief Key for the reduced maze path (NULL-terminated string)
+ */
+#define FLASHSTORE_PATH       1
+/**
+ * \brief Key for the infrared distance sensor calibration tables
+ */
+#define FLASHSTORE_IRCAL      4
+/**
+ * \brief Key for the tunable parameters of the command shell
+ */
+#define FLASHSTORE_PARAMS     5
+/**
+ * \brief Key for the tachometer length of each segment of the reduced maze path
+ */
+#define FLASHSTORE_SEGMENTS   6
+
+/**
+ * Scan the log sectors and build the RAM index of the
+ * newest valid record for each key.  Blank sectors are
+ * prepared for use.
+ * @param none
+ * @return 'NOERROR' if successful, 'ERROR' if a sector could not be prepared
+ * @note  This function is not interrupt safe.
+ * @brief  Initialize the flash store
+ */
+int FlashStore_Init(void);
+
+/**
+ * Append a new value for a key to the log.  The previous
+ * value stays in flash until its sector is recycled, but
+ * FlashStore_Read() will return the new one.
+ * @param key  record key (0 to FLASHSTORE_KEYS-1)
+ * @param data pointer to the bytes to save
+ * @param len  number of bytes (0 to FLASHSTORE_MAXLEN)
+ * @return 'NOERROR' if successful, 'ERROR' if fail
+ * @note  Runs with interrupts disabled while programming the flash.
+ *        If no erased sector is ready, a 4 KB erase is done first.
+ * @see FlashStore_Read(), FlashStore_Background()
+ * @brief  Save a record
+ */
+int FlashStore_Write(uint8_t key, const void *data, uint16_t len);
+
+/**
+ * Copy the newest value of a key out of flash.
+ * @param key  record key (0 to FLASHSTORE_KEYS-1)
+ * @param data pointer to buffer to hold the value
+ * @param max  size of the buffer in bytes
+ * @return length of the stored value in bytes, or -1 if the key has never been saved
+ * @note  At most max bytes are copied, even if the stored value is longer.
+ * @see FlashStore_Write()
+ * @brief  Read a record
+ */
+int FlashStore_Read(uint8_t key, void *data, uint16_t max);
+
+/**
+ * Erase one sector that was recycled by FlashStore_Write(),
+ * if any.  Call this when the robot is idle (e.g., while
+ * waiting for a button) so saves never wait for an erase.
+ * @param none
+ * @return 1 if a sector was erased, 0 if there was nothing to do
+ * @note  Takes tens of ms when it erases; interrupts are disabled meanwhile.
+ * @brief  Do pending flash store housekeeping
+ */
+int FlashStore_Background(void);
+
+#endif /* FLASHSTORE_H_ */
@@ -0,0 +1,162 @@
+// Format.c
+// Runs on MSP432
+// Convert numbers to ASCII strings without recursion or
+// divide instructions, for all of the output drivers.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/Format.h"
+
+static const char Digits2[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+static const uint32_t Pow10[10] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// number of decimal digits in n, at least 1
+static int digits(uint32_t n){int d = 1;
+  while((d < 10) && (n >= Pow10[d])){
+    d = d + 1;
+  }
+  return d;
+}
+
+// write the low d digits of n, with leading zeros, ending just
+// before end, and return the digits above them
+static uint32_t fill(char *end, uint32_t n, int d){uint32_t q, r;
+  while(d >= 2){
+    q = ((uint64_t)n*0x51EB851F)>>37; // n/100, exact for all 32-bit n
+    r = n - 100*q;
+    end = end - 2;
+    end[0] = Digits2[2*r];
+    end[1] = Digits2[2*r+1];
+    n = q;
+    d = d - 2;
+  }
+  if(d){
+    q = ((uint64_t)n*0xCCCCCCCD)>>35; // n/10, exact for all 32-bit n
+    end[-1] = '0' + (n - 10*q);
+    n = q;
+  }
+  return n;
+}
+
+// right justify len characters at buf in width, or fill with '*'
+static int justify(char *buf, int len, int width){int i;
+  if(width == 0){
+    buf[len] = 0;
+    return len;
+  }
+  if(len > width){
+    for(i=0; i<width; i++){
+      buf[i] = '*';
+    }
+  }else{
+    for(i=width-1; i>=width-len; i--){
+      buf[i] = buf[i-(width-len)];
+    }
+    for(; i>=0; i--){
+      buf[i] = ' ';
+    }
+  }
+  buf[width] = 0;
+  return width;
+}
+
+//-----------------------Format_UDec-----------------------
+// Convert an unsigned number to decimal.
+// Input: buf is at least FORMAT_SIZE and width+1 characters
+//        n is the number
+//        width is 0 for variable, or 1 to 12 characters
+// Output: number of characters, not counting the null
+int Format_UDec(char *buf, uint32_t n, int width){int d;
+  d = digits(n);
+  fill(buf+d, n, d);
+  return justify(buf, d, width);
+}
+
+//-----------------------Format_SDec-----------------------
+// Convert a signed number to decimal.
+// Input: buf is at least FORMAT_SIZE and width+1 characters
+//        n is the number
+//        width is 0 for variable, or 1 to 12 characters
+// Output: number of characters, not counting the null
+int Format_SDec(char *buf, int32_t n, int width){int d; uint32_t u;
+  if(n < 0){
+    u = -(uint32_t)n;              // works for -2147483648
+    buf[0] = '-';
+    d = digits(u);
+    fill(buf+1+d, u, d);
+    return justify(buf, d+1, width);
+  }
+  return Format_UDec(buf, n, width);
+}
+
+//-----------------------Format_UFix-----------------------
+// Convert an unsigned fixed-point number to decimal,
+// e.g., 1234 with 2 decimals is "12.34".
+// Input: buf is at least FORMAT_SIZE and width+1 characters
+//        n is the number in units of 10^-decimals
+//        decimals is digits after the decimal point, 1 to 9
+//        width is 0 for variable, or 1 to 12 characters
+// Output: number of characters, not counting the null
+int Format_UFix(char *buf, uint32_t n, int decimals, int width){int d;
+  if((decimals < 1) || (decimals > 9)){
+    return Format_UDec(buf, n, width);
+  }
+  d = digits(n);
+  if(d <= decimals){
+    d = decimals + 1;              // at least one digit before the point
+  }
+  n = fill(buf+d+1, n, decimals);  // fraction first, leaves the integer part
+  buf[d-decimals] = '.';
+  fill(buf+d-decimals, n, d-decimals);
+  return justify(buf, d+1, width);
+}
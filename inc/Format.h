@@ -0,0 +1,104 @@
+/**
+ * @file      Format.h
+ * @brief     Convert numbers to ASCII strings for the output drivers
+ * @details   One formatting core shared by UART0, EUSCIA0, TExaS
+ * and the Nokia5110 LCD.  Numbers are written into a buffer the
+ * caller provides, so a driver sends the result with one string
+ * output.  Digits are produced two at a time from a table, and
+ * the divides by 100 and 10 are multiplies by their reciprocals,
+ * so there is no recursion and no divide instruction at all.
+ * Bench_Format() times them against the divide versions.<br>
+ * Each function takes a width.  With width 0 the number uses as
+ * many characters as it needs.  Otherwise it is right justified
+ * in width characters padded with spaces, or width '*' characters
+ * if it does not fit.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+/**
+ * \brief size of a buffer that holds any number with width 0:
+ * sign, 10 digits, decimal point and null
+ */
+#define FORMAT_SIZE 13
+
+/**
+ * Convert an unsigned number to decimal.
+ * @param buf is the buffer, at least FORMAT_SIZE and width+1 characters
+ * @param n is the number
+ * @param width is 0 for variable, or 1 to 12 characters
+ * @return number of characters, not counting the null
+ * @brief  Format an unsigned decimal number
+ */
+int Format_UDec(char *buf, uint32_t n, int width);
+
+/**
+ * Convert a signed number to decimal, with a '-' just before
+ * the digits if it is negative.
+ * @param buf is the buffer, at least FORMAT_SIZE and width+1 characters
+ * @param n is the number
+ * @param width is 0 for variable, or 1 to 12 characters
+ * @return number of characters, not counting the null
+ * @brief  Format a signed decimal number
+ */
+int Format_SDec(char *buf, int32_t n, int width);
+
+/**
+ * Convert an unsigned fixed-point number with a resolution of
+ * 10^-decimals to decimal, e.g., 1234 with 2 decimals is "12.34"
+ * and 5 is "0.05".
+ * @param buf is the buffer, at least FORMAT_SIZE and width+1 characters
+ * @param n is the number in units of 10^-decimals
+ * @param decimals is digits after the decimal point, 1 to 9
+ * @param width is 0 for variable, or 1 to 12 characters
+ * @return number of characters, not counting the null
+ * @brief  Format an unsigned fixed-point number
+ */
+int Format_UFix(char *buf, uint32_t n, int decimals, int width);
+
+#endif /* FORMAT_H_ */
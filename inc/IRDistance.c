@@ -54,20 +54,147 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "../inc/ADC14.h"
+#include "../inc/FlashProgram.h"
+#include "../inc/FlashStore.h"
+#include "../inc/IRDistance.h"
 #include "msp.h"
 
+// Each sensor has a table of IR_POINTS calibration points,
+// sorted by increasing ADC value (decreasing distance).
+// Between two points the distance is interpolated along a
+// straight line whose slope is computed once, when the table
+// is loaded, so a conversion needs no divide.
+struct IRTable{
+  uint16_t adc[IR_POINTS];         // ADC sample, increasing
+  uint16_t mm[IR_POINTS];          // distance in mm, decreasing
+};
+// Typical GP2Y0A21YK0F curve, D = 1195172/(n - 1058) + 40,
+// used until a calibration has been saved
+static const struct IRTable DefaultTable = {
+  {2631, 3192, 4378, 5655, 6749, 8528, 11923, 15998},
+  { 800,  600,  400,  300,  250,  200,   150,   120}
+};
+static struct IRTable Table[3];    // IR_LEFT, IR_CENTER, IR_RIGHT
+static int32_t Slope[3][IR_POINTS-1]; // mm per ADC count, 4096 means 1
+
+// Private helper: check a table and compute its slopes.
+// Returns ERROR unless ADC values increase and distances
+// do not increase from one point to the next.
+static int loadtable(uint32_t sensor, const struct IRTable *t){
+  uint32_t i;
+  for(i=0; i<(IR_POINTS-1); i=i+1){
+    if((t->adc[i+1] <= t->adc[i]) || (t->mm[i+1] > t->mm[i])){
+      return ERROR;
+    }
+  }
+  Table[sensor] = *t;
+  for(i=0; i<(IR_POINTS-1); i=i+1){
+    Slope[sensor][i] = (((int32_t)t->mm[i+1] - (int32_t)t->mm[i])*4096)/
+                       ((int32_t)t->adc[i+1] - (int32_t)t->adc[i]);
+  }
+  return NOERROR;
+}
+
+//------------IRDistance_Init------------
+// Load the calibration tables saved by IRDistance_Calibrate(),
+// or the typical tables if none were saved.
+// Input: none
+// Output: 1 if a saved calibration was loaded, 0 if using typical tables
+// Assumes: FlashStore_Init() has been called
+int IRDistance_Init(void){
+  struct IRTable saved[3];
+  uint32_t sensor;
+  if(FlashStore_Read(FLASHSTORE_IRCAL, saved, sizeof(saved)) == sizeof(saved)){
+    if((loadtable(IR_LEFT, &saved[IR_LEFT]) == NOERROR) &&
+       (loadtable(IR_CENTER, &saved[IR_CENTER]) == NOERROR) &&
+       (loadtable(IR_RIGHT, &saved[IR_RIGHT]) == NOERROR)){
+      return 1;
+    }
+  }
+  for(sensor=0; sensor<3; sensor=sensor+1){
+    loadtable(sensor, &DefaultTable);
+  }
+  return 0;
+}
+
+//------------IRDistance_Convert------------
+// Convert an ADC sample to distance with the table of one
+// sensor.  The binary search always takes log2(IR_POINTS)
+// steps, and the interpolation is one multiply and shift.
+// Input: sensor  IR_LEFT, IR_CENTER, or IR_RIGHT
+//        n       14-bit ADC sample 0 to 16383
+// Output: distance in mm, IRDISTANCE_TOOFAR below the first
+//         point, IRDISTANCE_TOOCLOSE above the last point
+int32_t IRDistance_Convert(uint32_t sensor, int32_t n){
+  const struct IRTable *t = &Table[sensor];
+  uint32_t lo = 0, step;
+  if(n < t->adc[0]){
+    return IRDISTANCE_TOOFAR;
+  }
+  if(n > t->adc[IR_POINTS-1]){
+    return IRDISTANCE_TOOCLOSE;
+  }
+  for(step=IR_POINTS/2; step>0; step=step>>1){
+    lo = lo + ((n >= t->adc[lo+step]) ? step : 0);
+  }
+  if(lo == (IR_POINTS-1)){
+    return t->mm[IR_POINTS-1];     // exactly on the last point
+  }
+  return t->mm[lo] + ((Slope[sensor][lo]*(n - t->adc[lo]))>>12);
+}
 
 int32_t LeftConvert(int32_t nl){        // returns left distance in mm
-  // write this for Lab 15
-  return 0; // replace this line
+  return IRDistance_Convert(IR_LEFT, nl);
 }
 
 int32_t CenterConvert(int32_t nc){   // returns center distance in mm
-  // write this for Lab 15
-  return 0; // replace this line
+  return IRDistance_Convert(IR_CENTER, nc);
 }
 
 int32_t RightConvert(int32_t nr){      // returns right distance in mm
-  // write this for Lab 15
-  return 0; // replace this line
+  return IRDistance_Convert(IR_RIGHT, nr);
+}
+
+//------------IRDistance_Calibrate------------
+// Build new tables for all three sensors.  For each of the
+// IR_POINTS distances of the typical table, the caller's
+// function is called to place a wall at that distance from
+// the robot center (e.g., prompt on the LCD and wait for a
+// switch); then 16 new samples of each sensor are averaged.
+// The new tables are checked and saved in flash.
+// Input: wait  function called with the distance in mm,
+//              returns when the wall is in place
+// Output: 'NOERROR' if successful, 'ERROR' if a table is
+//         not monotonic or could not be saved
+// Assumes: ADC0_InitTimerTriggerCh17_12_16() has been called
+//          and interrupts are enabled
+int IRDistance_Calibrate(void(*wait)(uint16_t mm)){
+  struct IRTable cal[3];
+  uint32_t point, i, count, last, ch17, ch12, ch16, sum17, sum12, sum16;
+  for(point=0; point<IR_POINTS; point=point+1){
+    (*wait)(DefaultTable.mm[point]);
+    sum17 = sum12 = sum16 = 0;
+    last = ADC_Latest17_12_16(&ch17, &ch12, &ch16);
+    for(i=0; i<16; i=i+1){
+      do{
+        count = ADC_Latest17_12_16(&ch17, &ch12, &ch16);
+      }while(count == last);       // wait for a new sequence
+      last = count;
+      sum17 = sum17 + ch17;
+      sum12 = sum12 + ch12;
+      sum16 = sum16 + ch16;
+    }
+    cal[IR_LEFT].adc[point] = sum16/16;   // P9.1/A16 is the left sensor
+    cal[IR_CENTER].adc[point] = sum12/16; // P4.1/A12 is the center sensor
+    cal[IR_RIGHT].adc[point] = sum17/16;  // P9.0/A17 is the right sensor
+    cal[IR_LEFT].mm[point] = cal[IR_CENTER].mm[point] = cal[IR_RIGHT].mm[point] = DefaultTable.mm[point];
+  }
+  // the typical table lists far points first, so points already have increasing ADC values
+  if((loadtable(IR_LEFT, &cal[IR_LEFT]) != NOERROR) ||
+     (loadtable(IR_CENTER, &cal[IR_CENTER]) != NOERROR) ||
+     (loadtable(IR_RIGHT, &cal[IR_RIGHT]) != NOERROR)){
+    IRDistance_Init();             // keep the previous tables
+    return ERROR;
+  }
+  return FlashStore_Write(FLASHSTORE_IRCAL, cal, sizeof(cal));
 }
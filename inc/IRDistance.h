@@ -62,35 +62,92 @@ policies, either expressed or implied, of the FreeBSD Project.
 #ifndef IRDISTANCE_H_
 #define IRDISTANCE_H_
 
+/**
+ * \brief Sensor numbers for IRDistance_Convert()
+ */
+#define IR_LEFT    0  /**< left sensor, P9.1/A16 */
+#define IR_CENTER  1  /**< center sensor, P4.1/A12 */
+#define IR_RIGHT   2  /**< right sensor, P9.0/A17 */
+/**
+ * \brief Number of calibration points per sensor, must be a power of 2
+ */
+#define IR_POINTS  8
+/**
+ * \brief Returned when the wall is beyond the calibrated range
+ */
+#define IRDISTANCE_TOOFAR    32767
+/**
+ * \brief Returned when the wall is closer than the calibrated range
+ */
+#define IRDISTANCE_TOOCLOSE  0
+
+/**
+ * Load the sensor calibration tables saved in flash by
+ * IRDistance_Calibrate(), or typical tables if none were saved.
+ * @param none
+ * @return 1 if a saved calibration was loaded, 0 if using typical tables
+ * @note  Assumes FlashStore_Init() has been called
+ * @brief  Initialize infrared distance conversion
+ */
+int IRDistance_Init(void);
 
 /**
  * Convert ADC sample into distance for the GP2Y0A21YK0F
- * infrared distance sensor.  Conversion uses a calibration formula<br>
- * Dl = Al/(nl + Bl) + Cl
+ * infrared distance sensor.  A binary search finds the two
+ * calibration points around the sample, and the distance is
+ * interpolated between them with integer math and no divide.
+ * @param sensor IR_LEFT, IR_CENTER, or IR_RIGHT
+ * @param n is the 14-bit ADC sample 0 to 16383
+ * @return distance from robot center to wall (units mm),
+ *         IRDISTANCE_TOOFAR or IRDISTANCE_TOOCLOSE if out of range
+ * @brief  Convert infrared distance measurement
+ */
+int32_t IRDistance_Convert(uint32_t sensor, int32_t n);
+
+/**
+ * Convert ADC sample into distance for the GP2Y0A21YK0F
+ * infrared distance sensor.  Conversion uses the left
+ * calibration table.
  * @param nl is the 14-bit ADC sample 0 to 16383
  * @return distance from robot center to left wall (units mm)
+ * @see IRDistance_Convert()
  * @brief  Convert left infrared distance measurement
  */
 int32_t LeftConvert(int32_t nl);
 
 /**
  * Convert ADC sample into distance for the GP2Y0A21YK0F
- * infrared distance sensor.  Conversion uses a calibration formula<br>
- * Dc = Ac/(nc + Bc) + Cc
+ * infrared distance sensor.  Conversion uses the center
+ * calibration table.
  * @param nc is the 14-bit ADC sample 0 to 16383
  * @return distance from robot center to center wall (units mm)
+ * @see IRDistance_Convert()
  * @brief  Convert center infrared distance measurement
  */
 int32_t CenterConvert(int32_t nc);
 
 /**
  * Convert ADC sample into distance for the GP2Y0A21YK0F
- * infrared distance sensor.  Conversion uses a calibration formula<br>
- * Dr = Ar/(nr + Br) + Cr
+ * infrared distance sensor.  Conversion uses the right
+ * calibration table.
  * @param nr is the 14-bit ADC sample 0 to 16383
  * @return distance from robot center to right wall (units mm)
+ * @see IRDistance_Convert()
  * @brief  Convert right infrared distance measurement
  */
 int32_t RightConvert(int32_t nr);      // returns right distance in mm
 
+/**
+ * Measure new calibration tables for all three sensors
+ * and save them in flash.  For each calibration distance
+ * the given function is called; it should return once a
+ * wall has been placed at that distance from the robot
+ * center.  Sixteen samples of each sensor are then averaged.
+ * @param wait function called with the distance in mm
+ * @return 'NOERROR' if successful, 'ERROR' if a table is not monotonic or could not be saved
+ * @note  Assumes ADC0_InitTimerTriggerCh17_12_16() has been called and interrupts are enabled
+ * @brief  Calibrate infrared distance sensors
+ */
+int IRDistance_Calibrate(void(*wait)(uint16_t mm));
+
 #endif /* IRDISTANCE_H_ */
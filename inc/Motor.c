@@ -61,6 +61,11 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 // *******Lab 13 solution*******
 
+// Most recent duty cycles sent to the wheels, negative
+// when the wheel is running backward, 0 when stopped.
+// Read with Motor_GetDuty() for logging and display.
+static int16_t LeftDuty=0, RightDuty=0;
+
 // ------------Motor_Init------------
 // Initialize GPIO pins for output, which will be
 // used to control the direction of the motors and
@@ -90,7 +95,8 @@ void Motor_Init(void){
 // Output: none
 void Motor_Stop(void){
     P3->OUT &= ~0xC0;// write this as part of Lab 13
-  
+    LeftDuty = 0;
+    RightDuty = 0;
 }
 
 // ------------Motor_Forward------------
@@ -106,6 +112,8 @@ void Motor_Forward(uint16_t leftDuty, uint16_t rightDuty){
     PWM_Duty3(rightDuty);
     PWM_Duty4(leftDuty);
     P3->OUT |= 0xC0;
+    LeftDuty = leftDuty;
+    RightDuty = rightDuty;
 // write this as part of Lab 13
   
 }
@@ -124,7 +132,8 @@ void Motor_Right(uint16_t leftDuty, uint16_t rightDuty){
         PWM_Duty3(rightDuty);
         PWM_Duty4(leftDuty);
         P3->OUT |= 0xC0;// write this as part of Lab 13
-
+        LeftDuty = leftDuty;
+        RightDuty = -(int16_t)rightDuty;
 }
 
 // ------------Motor_Left------------
@@ -141,7 +150,8 @@ void Motor_Left(uint16_t leftDuty, uint16_t rightDuty){
       PWM_Duty3(rightDuty);
       PWM_Duty4(leftDuty);
       P3->OUT |= 0xC0;// write this as part of Lab 13// write this as part of Lab 13
-
+      LeftDuty = -(int16_t)leftDuty;
+      RightDuty = rightDuty;
 }
 
 // ------------Motor_Backward------------
@@ -157,5 +167,18 @@ void Motor_Backward(uint16_t leftDuty, uint16_t rightDuty){
        PWM_Duty3(rightDuty);
        PWM_Duty4(leftDuty);
        P3->OUT |= 0xC0;// write this as part of Lab 13
+       LeftDuty = -(int16_t)leftDuty;
+       RightDuty = -(int16_t)rightDuty;
+}
 
+// ------------Motor_GetDuty------------
+// Return the duty cycles most recently applied to the
+// wheels.  A wheel running backward reports a negative
+// duty cycle, and both are 0 after Motor_Stop().
+// Input: left  pointer to store left wheel duty (-14,998 to 14,998)
+//        right pointer to store right wheel duty (-14,998 to 14,998)
+// Output: none
+void Motor_GetDuty(int16_t *left, int16_t *right){
+  *left = LeftDuty;
+  *right = RightDuty;
 }
@@ -137,4 +137,16 @@ void Motor_Left(uint16_t leftDuty, uint16_t rightDuty);
  */
 void Motor_Backward(uint16_t leftDuty, uint16_t rightDuty);
 
+/**
+ * Return the duty cycles most recently applied to the
+ * wheels by Motor_Forward(), Motor_Right(), Motor_Left(),
+ * or Motor_Backward().
+ * @param left  pointer to store left wheel duty cycle (-14,998 to 14,998)
+ * @param right pointer to store right wheel duty cycle (-14,998 to 14,998)
+ * @return none
+ * @note A wheel running backward reports a negative duty cycle; both are 0 after Motor_Stop().
+ * @brief  Read back the motor duty cycles
+ */
+void Motor_GetDuty(int16_t *left, int16_t *right);
+
 #endif /* MOTOR_H_ */
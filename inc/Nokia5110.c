@@ -78,6 +78,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "msp.h"
 #include "Nokia5110.h"
+#include "../inc/Format.h"
 
 // *************************** Screen dimensions ***************************
 #define SCREENW     84
@@ -217,8 +218,10 @@ static const uint8_t ASCII[][5] = {
 // 3) Write command to TXBUF, starts SPI
 // 4) Wait for SPI to be idle (after transmission complete)
 void static lcdcommandwrite(uint8_t command){
-// write this code as part of Lab 11
-
+  while(EUSCI_A3->STATW&0x0001){};      // wait for SPI to be idle
+  DC = 0;                               // command mode
+  EUSCI_A3->TXBUF = command;            // start transmission
+  while(EUSCI_A3->STATW&0x0001){};      // wait for transmission to finish
 }
 // This is a helper function that sends 8-bit data to the LCD.
 // Inputs: data  8-bit data to transmit
@@ -230,8 +233,9 @@ void static lcdcommandwrite(uint8_t command){
 // 2) Set DC for data (1)
 // 3) Write data to TXBUF, starts SPI
 void static lcddatawrite(uint8_t data){
-// write this code as part of Lab 11
-
+  while((EUSCI_A3->IFG&0x0002) == 0){}; // wait for transmit buffer empty
+  DC = 1;                               // data mode
+  EUSCI_A3->TXBUF = data;               // start transmission
 }
 
 //********Nokia5110_Init*****************
@@ -318,8 +322,10 @@ void Nokia5110_OutChar(char data){int i;
 // Outputs: none
 // Assumes: LCD is in default horizontal addressing mode (V = 0)
 void Nokia5110_OutString(char *ptr){
-// write this code as part of Lab 11
-
+  while(*ptr){
+    Nokia5110_OutChar((unsigned char)*ptr);
+    ptr = ptr + 1;
+  }
 }
 
 //********Nokia5110_OutUDec*****************
@@ -328,9 +334,9 @@ void Nokia5110_OutString(char *ptr){
 // Inputs: n  16-bit unsigned number
 // Outputs: none
 // Assumes: LCD is in default horizontal addressing mode (V = 0)
-void Nokia5110_OutUDec(uint16_t n){
-// write this code as part of Lab 11
-
+void Nokia5110_OutUDec(uint16_t n){char message[FORMAT_SIZE];
+  Format_UDec(message, n, 5);
+  Nokia5110_OutString(message);
 }
 
 //********Nokia5110_OutSDec*****************
@@ -339,9 +345,9 @@ void Nokia5110_OutUDec(uint16_t n){
 // Inputs: n  16-bit signed number
 // Outputs: none
 // Assumes: LCD is in default horizontal addressing mode (V = 0)
-void Nokia5110_OutSDec(int16_t n){
-// write this code as part of Lab 11
-
+void Nokia5110_OutSDec(int16_t n){char message[FORMAT_SIZE];
+  Format_SDec(message, n, 6);
+  Nokia5110_OutString(message);
 }
 
 //********Nokia5110_OutUFix1*****************
@@ -349,20 +355,9 @@ void Nokia5110_OutSDec(int16_t n){
 // numbers 0 to 999 printed as " 0.0" to "99.9"
 // Inputs: n  16-bit unsigned number
 // Outputs: none
-void Nokia5110_OutUFix1(uint16_t n){
-  char message[5];
+void Nokia5110_OutUFix1(uint16_t n){char message[FORMAT_SIZE];
   if(n>999)n=999;
-  if(n>=100){  // 100 to 999
-    message[0] = (n/100+'0'); /* tens digit */
-    n = n%100; //the rest
-  }else { // 0 to 99
-    message[0] = ' '; /* n is between 0.0 and 9.9 */
-  }
-  message[1] = (n/10+'0'); /* ones digit */
-  n = n%10; //the rest
-  message[2] = '.';
-  message[3] = (n+'0'); /* tenths digit */
-  message[4] = 0;
+  Format_UFix(message, n, 1, 4);
   Nokia5110_OutString(message);
 }
 
@@ -529,3 +524,308 @@ void Nokia5110_SetPxl(uint32_t i, uint32_t j){
   Screen[84*(i>>3) + j] |= Masks[i&0x07];
 }
 
+//------------plotbyte------------
+// Private helper that combines a pixel mask into one byte
+// of the internal screen buffer using the requested mode.
+// Input: index  byte offset into Screen (0 to 503)
+//        mask   pixels in this byte that are affected
+//        mode   PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void static plotbyte(uint32_t index, uint8_t mask, uint8_t mode){
+  if(mode == PIXEL_ON){
+    Screen[index] |= mask;
+  } else if(mode == PIXEL_OFF){
+    Screen[index] &= ~mask;
+  } else{
+    Screen[index] ^= mask;
+  }
+}
+
+//------------Nokia5110_DrawHLine------------
+// Draw a horizontal line into the internal screen buffer.
+// Every pixel of a horizontal line shares one bit of one
+// bank, so the mask and buffer pointer are computed once
+// and the loop only walks consecutive bytes.
+// Input: x0    left column  (clipped to 0 to 83)
+//        x1    right column (clipped to 0 to 83)
+//        y     row (0 to 47), nothing drawn if off screen
+//        mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void Nokia5110_DrawHLine(int32_t x0, int32_t x1, int32_t y, uint8_t mode){
+  uint8_t *pt, mask;
+  int32_t x;
+  if(x0 > x1){ x = x0; x0 = x1; x1 = x; }
+  if((y < 0) || (y >= SCREENH) || (x1 < 0) || (x0 >= SCREENW)){
+    return;                     // completely off screen
+  }
+  if(x0 < 0) x0 = 0;
+  if(x1 >= SCREENW) x1 = SCREENW - 1;
+  pt = &Screen[SCREENW*(y>>3) + x0];
+  mask = Masks[y&0x07];
+  x = x1 - x0 + 1;
+  if(mode == PIXEL_ON){
+    while(x){ *pt |= mask; pt++; x--; }
+  } else if(mode == PIXEL_OFF){
+    mask = ~mask;
+    while(x){ *pt &= mask; pt++; x--; }
+  } else{
+    while(x){ *pt ^= mask; pt++; x--; }
+  }
+}
+
+//------------Nokia5110_DrawVLine------------
+// Draw a vertical line into the internal screen buffer.
+// Rows are packed eight per byte, so the partial banks at
+// either end get a mask and every bank in between is
+// written as a whole byte.
+// Input: x     column (0 to 83), nothing drawn if off screen
+//        y0    top row    (clipped to 0 to 47)
+//        y1    bottom row (clipped to 0 to 47)
+//        mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void Nokia5110_DrawVLine(int32_t x, int32_t y0, int32_t y1, uint8_t mode){
+  uint32_t bank0, bank1, bank;
+  uint8_t mask0, mask1;
+  int32_t y;
+  if(y0 > y1){ y = y0; y0 = y1; y1 = y; }
+  if((x < 0) || (x >= SCREENW) || (y1 < 0) || (y0 >= SCREENH)){
+    return;                     // completely off screen
+  }
+  if(y0 < 0) y0 = 0;
+  if(y1 >= SCREENH) y1 = SCREENH - 1;
+  bank0 = y0>>3;
+  bank1 = y1>>3;
+  mask0 = 0xFF<<(y0&0x07);      // rows y0 and below in the first bank
+  mask1 = 0xFF>>(7-(y1&0x07));  // rows y1 and above in the last bank
+  if(bank0 == bank1){
+    plotbyte(SCREENW*bank0 + x, mask0&mask1, mode);
+    return;
+  }
+  plotbyte(SCREENW*bank0 + x, mask0, mode);
+  for(bank=bank0+1; bank<bank1; bank=bank+1){
+    plotbyte(SCREENW*bank + x, 0xFF, mode);
+  }
+  plotbyte(SCREENW*bank1 + x, mask1, mode);
+}
+
+//------------Nokia5110_DrawLine------------
+// Draw a straight line into the internal screen buffer
+// using Bresenham's integer algorithm.  Horizontal and
+// vertical lines are sent to the faster special cases.
+// Pixels that fall outside the screen are skipped.
+// Input: x0,y0  first end point (column, row)
+//        x1,y1  second end point (column, row)
+//        mode   PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void Nokia5110_DrawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t mode){
+  int32_t dx, dy, sx, sy, err, e2;
+  if(y0 == y1){
+    Nokia5110_DrawHLine(x0, x1, y0, mode);
+    return;
+  }
+  if(x0 == x1){
+    Nokia5110_DrawVLine(x0, y0, y1, mode);
+    return;
+  }
+  dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+  dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);    // dy is negative
+  sx = (x0 < x1) ? 1 : -1;
+  sy = (y0 < y1) ? 1 : -1;
+  err = dx + dy;
+  while(1){
+    if((x0 >= 0) && (x0 < SCREENW) && (y0 >= 0) && (y0 < SCREENH)){
+      plotbyte(SCREENW*(y0>>3) + x0, Masks[y0&0x07], mode);
+    }
+    if((x0 == x1) && (y0 == y1)){
+      return;
+    }
+    e2 = 2*err;
+    if(e2 >= dy){
+      err = err + dy;
+      x0 = x0 + sx;
+    }
+    if(e2 <= dx){
+      err = err + dx;
+      y0 = y0 + sy;
+    }
+  }
+}
+
+//------------Nokia5110_DrawRect------------
+// Draw the outline of a rectangle into the internal
+// screen buffer.  The outline is one pixel wide.
+// Input: x     left column
+//        y     top row
+//        w     width in pixels (must be at least 1)
+//        h     height in pixels (must be at least 1)
+//        mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void Nokia5110_DrawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t mode){
+  if((w <= 0) || (h <= 0)){
+    return;
+  }
+  Nokia5110_DrawHLine(x, x+w-1, y, mode);
+  if(h > 1){
+    Nokia5110_DrawHLine(x, x+w-1, y+h-1, mode);
+  }
+  if(h > 2){                    // sides without the corners, so XOR mode works
+    Nokia5110_DrawVLine(x, y+1, y+h-2, mode);
+    if(w > 1){
+      Nokia5110_DrawVLine(x+w-1, y+1, y+h-2, mode);
+    }
+  }
+}
+
+//------------Nokia5110_FillRect------------
+// Fill a rectangle in the internal screen buffer.  Each
+// bank the rectangle touches is handled with one mask,
+// so the inner loop writes whole bytes.
+// Input: x     left column
+//        y     top row
+//        w     width in pixels
+//        h     height in pixels
+//        mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+// Output: none
+void Nokia5110_FillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t mode){
+  int32_t x1 = x + w - 1, y1 = y + h - 1, i;
+  uint32_t bank, bank0, bank1;
+  uint8_t mask, *pt;
+  if((w <= 0) || (h <= 0) || (x1 < 0) || (y1 < 0) || (x >= SCREENW) || (y >= SCREENH)){
+    return;
+  }
+  if(x < 0) x = 0;
+  if(y < 0) y = 0;
+  if(x1 >= SCREENW) x1 = SCREENW - 1;
+  if(y1 >= SCREENH) y1 = SCREENH - 1;
+  bank0 = y>>3;
+  bank1 = y1>>3;
+  for(bank=bank0; bank<=bank1; bank=bank+1){
+    mask = 0xFF;
+    if(bank == bank0) mask &= 0xFF<<(y&0x07);
+    if(bank == bank1) mask &= 0xFF>>(7-(y1&0x07));
+    pt = &Screen[SCREENW*bank + x];
+    for(i=x; i<=x1; i=i+1){
+      if(mode == PIXEL_ON){
+        *pt |= mask;
+      } else if(mode == PIXEL_OFF){
+        *pt &= ~mask;
+      } else{
+        *pt ^= mask;
+      }
+      pt++;
+    }
+  }
+}
+
+//------------Nokia5110_DrawChar------------
+// Blit one character of the 5x8 font into the internal
+// screen buffer with its top left corner at any pixel.
+// The character cell is opaque: the 6x8 cell (five font
+// columns plus one blank column) is cleared before the
+// glyph is drawn, so text can be rewritten in place.
+// When y is not a multiple of 8, each font column is
+// split across two banks with one shift.
+// Input: x     left column of the character cell
+//        y     top row of the character cell
+//        data  character to draw (0x20 to 0x7F)
+// Output: none
+void Nokia5110_DrawChar(int32_t x, int32_t y, char data){
+  uint32_t shift, bank, i;
+  uint16_t col, keep;
+  int32_t xi;
+  if((data < 0x20) || (data > 0x7F)){
+    data = '?';                 // no glyph for control characters
+  }
+  if((x <= -6) || (x >= SCREENW) || (y <= -8) || (y >= SCREENH)){
+    return;                     // completely off screen
+  }
+  if(y < 0){                    // top cut off; fall back to per-pixel clipping
+    for(i=0; i<6; i=i+1){
+      col = (i < 5) ? ASCII[data - 0x20][i] : 0;
+      xi = x + i;
+      if((xi >= 0) && (xi < SCREENW)){
+        for(shift=(uint32_t)(-y); shift<8; shift=shift+1){
+          plotbyte(xi + SCREENW*((y+shift)>>3), Masks[(y+shift)&0x07],
+                   (col&Masks[shift]) ? PIXEL_ON : PIXEL_OFF);
+        }
+      }
+    }
+    return;
+  }
+  bank = y>>3;
+  shift = y&0x07;
+  keep = ~(0x00FF<<shift);      // rows outside the 8-row cell
+  for(i=0; i<6; i=i+1){
+    xi = x + i;
+    if((xi < 0) || (xi >= SCREENW)){
+      continue;
+    }
+    col = ((i < 5) ? ASCII[data - 0x20][i] : 0)<<shift;
+    Screen[SCREENW*bank + xi] = (Screen[SCREENW*bank + xi]&keep)|(col&0xFF);
+    if((shift != 0) && ((bank + 1) < (SCREENH/8))){
+      Screen[SCREENW*(bank+1) + xi] = (Screen[SCREENW*(bank+1) + xi]&(keep>>8))|(col>>8);
+    }
+  }
+}
+
+//------------Nokia5110_DrawString------------
+// Blit a string into the internal screen buffer starting
+// at any pixel.  Characters advance 6 pixels to the right
+// and are clipped at the right edge (no wrapping).
+// Input: x    left column of the first character
+//        y    top row of the string
+//        ptr  pointer to NULL-terminated ASCII string
+// Output: none
+void Nokia5110_DrawString(int32_t x, int32_t y, char *ptr){
+  while(*ptr && (x < SCREENW)){
+    Nokia5110_DrawChar(x, y, *ptr);
+    x = x + 6;
+    ptr = ptr + 1;
+  }
+}
+
+//------------Nokia5110_OutBufferPBM------------
+// Send the internal screen buffer as a plain (ASCII) PBM
+// image, one character at a time, through the given output
+// function.  On the robot pass UART0_OutChar to capture
+// the frame on the PC; on a host build pass a function
+// that wraps putchar or fputc to write a .pbm file.
+// Input: outchar  pointer to a function that outputs one character
+// Output: none
+void Nokia5110_OutBufferPBM(void(*outchar)(char)){
+  char *header = "P1\n84 48\n";
+  uint32_t i, j;
+  while(*header){
+    (*outchar)(*header);
+    header = header + 1;
+  }
+  for(i=0; i<SCREENH; i=i+1){
+    for(j=0; j<SCREENW; j=j+1){
+      (*outchar)((Screen[SCREENW*(i>>3) + j]&Masks[i&0x07]) ? '1' : '0');
+    }
+    (*outchar)('\n');
+  }
+}
+
+//------------Nokia5110_OutColumn------------
+// Write one full-height column (48 pixels) directly to
+// the LCD without touching the internal screen buffer.
+// The controller is switched to vertical addressing so
+// the six bytes fill the column from top to bottom, then
+// returned to the default horizontal addressing mode.
+// Input: x    column (0 to 83)
+//        col  pointer to 6 bytes; col[0] is rows 0-7 (LSB on top)
+// Output: none
+void Nokia5110_OutColumn(uint8_t x, const uint8_t col[6]){
+  uint32_t i;
+  if(x >= SCREENW){
+    return;                     // bad input
+  }
+  lcdcommandwrite(0x22);        // vertical addressing mode (V = 1), basic instruction set (H = 0)
+  lcdcommandwrite(0x80|x);      // setting bit 7 updates X-position
+  lcdcommandwrite(0x40);        // setting bit 6 updates Y-position, start at the top bank
+  for(i=0; i<SCREENH/8; i=i+1){
+    lcddatawrite(col[i]);
+  }
+  lcdcommandwrite(0x20);        // back to horizontal addressing mode (V = 0)
+}
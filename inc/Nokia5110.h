@@ -307,4 +307,141 @@ void Nokia5110_ClrPxl(uint32_t i, uint32_t j);
 void Nokia5110_SetPxl(uint32_t i, uint32_t j);
 
 
+/**
+ * \brief Pixel modes for the buffer drawing primitives
+ */
+#define PIXEL_OFF   0    /**< clear the pixels (white) */
+#define PIXEL_ON    1    /**< set the pixels (black) */
+#define PIXEL_XOR   2    /**< invert the pixels */
+
+/**
+ * Draw a horizontal line into the internal screen buffer.
+ * The end points may be given in either order and are
+ * clipped to the screen.
+ * @param x0    column of one end
+ * @param x1    column of the other end
+ * @param y     row (0 to 47)
+ * @param mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawVLine(), Nokia5110_DrawLine()
+ * @brief  Draw horizontal line in internal screen buffer.
+ */
+void Nokia5110_DrawHLine(int32_t x0, int32_t x1, int32_t y, uint8_t mode);
+
+/**
+ * Draw a vertical line into the internal screen buffer.
+ * The end points may be given in either order and are
+ * clipped to the screen.  Whole bytes are written for the
+ * 8-row banks the line fully covers.
+ * @param x     column (0 to 83)
+ * @param y0    row of one end
+ * @param y1    row of the other end
+ * @param mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawHLine(), Nokia5110_DrawLine()
+ * @brief  Draw vertical line in internal screen buffer.
+ */
+void Nokia5110_DrawVLine(int32_t x, int32_t y0, int32_t y1, uint8_t mode);
+
+/**
+ * Draw a straight line between two points into the
+ * internal screen buffer using Bresenham's algorithm.
+ * Pixels outside the screen are skipped.
+ * @param x0    column of the first point
+ * @param y0    row of the first point
+ * @param x1    column of the second point
+ * @param y1    row of the second point
+ * @param mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawHLine(), Nokia5110_DrawVLine()
+ * @brief  Draw line in internal screen buffer.
+ */
+void Nokia5110_DrawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t mode);
+
+/**
+ * Draw the one pixel wide outline of a rectangle into
+ * the internal screen buffer.
+ * @param x     left column
+ * @param y     top row
+ * @param w     width in pixels
+ * @param h     height in pixels
+ * @param mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_FillRect()
+ * @brief  Draw rectangle outline in internal screen buffer.
+ */
+void Nokia5110_DrawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t mode);
+
+/**
+ * Fill a rectangle in the internal screen buffer.  The
+ * rectangle is clipped to the screen.
+ * @param x     left column
+ * @param y     top row
+ * @param w     width in pixels
+ * @param h     height in pixels
+ * @param mode  PIXEL_OFF, PIXEL_ON, or PIXEL_XOR
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawRect()
+ * @brief  Fill rectangle in internal screen buffer.
+ */
+void Nokia5110_FillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t mode);
+
+/**
+ * Draw one character of the 5x8 font into the internal
+ * screen buffer at any pixel position.  The 6x8 character
+ * cell is opaque, so old text is overwritten.
+ * @param x     left column of the character cell
+ * @param y     top row of the character cell
+ * @param data  character to print
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawString(), Nokia5110_OutChar()
+ * @brief  Draw character in internal screen buffer.
+ */
+void Nokia5110_DrawChar(int32_t x, int32_t y, char data);
+
+/**
+ * Draw a string into the internal screen buffer at any
+ * pixel position.  Characters are 6 pixels apart and are
+ * clipped at the right edge without wrapping.
+ * @param x     left column of the first character
+ * @param y     top row of the string
+ * @param ptr   pointer to NULL-terminated ASCII string
+ * @return none
+ * @note Call Nokia5110_DisplayBuffer() to see this change.
+ * @see Nokia5110_DrawChar(), Nokia5110_OutString()
+ * @brief  Draw string in internal screen buffer.
+ */
+void Nokia5110_DrawString(int32_t x, int32_t y, char *ptr);
+
+/**
+ * Output the internal screen buffer as a plain PBM (P1)
+ * image so a frame can be captured and viewed on a PC.
+ * @param outchar  function that outputs one character, e.g., UART0_OutChar
+ * @return none
+ * @see Nokia5110_DisplayBuffer()
+ * @brief  Dump internal screen buffer as a PBM image.
+ */
+void Nokia5110_OutBufferPBM(void(*outchar)(char));
+
+
+/**
+ * Write one full-height column of 48 pixels directly to
+ * the LCD, bypassing the internal screen buffer.  This
+ * sends only 6 data bytes, so a display that changes one
+ * column at a time can be updated quickly.
+ * @param x    column (0 to 83)
+ * @param col  6 bytes; col[0] is rows 0 to 7 with the LSB on top
+ * @return none
+ * @note The display is left in horizontal addressing mode.
+ * @see Nokia5110_DrawFullImage()
+ * @brief  Output one column to the display.
+ */
+void Nokia5110_OutColumn(uint8_t x, const uint8_t col[6]);
+
 #endif /* NOKIA5110_H_ */
@@ -49,6 +49,16 @@ policies, either expressed or implied, of the FreeBSD Project.
 */
 
 #include "msp.h"
+#include "../inc/Timers.h"
+
+static int Timer = -1;           // Timer A0 from Timers_Request()
+// Allocate Timer A0 the first time, return -1 if it is in use
+static int pwmtimer(void){
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA0, TIMERS_PWM, 0, 0);
+  }
+  return (Timer < 0) ? -1 : 0;
+}
 
 //***************************PWM_Init1*******************************
 // PWM outputs on P2.4
@@ -62,6 +72,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 // Period of P2.4 is period*166.67ns, duty cycle is duty/period
 void PWM_Init1(uint16_t period, uint16_t duty){
   if(duty >= period) return;     // bad input
+  if(pwmtimer()) return;         // Timer A0 is in use
   P2->DIR |= 0x10;               // P2.4 output
   P2->SEL0 |= 0x10;              // P2.4 Timer0A functions
   P2->SEL1 &= ~0x10;             // P2.4 Timer0A functions
@@ -95,6 +106,7 @@ void PWM_Init1(uint16_t period, uint16_t duty){
 void PWM_Init12(uint16_t period, uint16_t duty1, uint16_t duty2){
   if(duty1 >= period) return; // bad input
   if(duty2 >= period) return; // bad input
+  if(pwmtimer()) return;      // Timer A0 is in use
   P2->DIR |= 0x30;          // P2.4, P2.5 output
   P2->SEL0 |= 0x30;         // P2.4, P2.5 Timer0A functions
   P2->SEL1 &= ~0x30;        // P2.4, P2.5 Timer0A functions
@@ -151,6 +163,7 @@ void PWM_Duty2(uint16_t duty2){
 void PWM_Init34(uint16_t period, uint16_t duty3, uint16_t duty4){
     if(duty3 >= period) return; // bad input
     if(duty4 >= period) return; // bad input
+    if(pwmtimer()) return;      // Timer A0 is in use
     P2->DIR |= 0xC0;          // P2.4, P2.5 output
     P2->SEL0 |= 0xC0;         // P2.4, P2.5 Timer0A functions
     P2->SEL1 &= ~0xC0;        // P2.4, P2.5 Timer0A functions
@@ -0,0 +1,141 @@
+// Profile.c
+// Runs on MSP432
+// Cycle-accurate profiling of code zones with the Cortex-M4
+// DWT cycle counter.  Each zone keeps its count, minimum,
+// maximum, total and a log2 histogram of cycles in RAM, and
+// the results can be sent over EUSCIA0.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/EUSCIA0.h"
+#include "../inc/Profile.h"
+
+struct ProfileZone Profile_Zones[PROFILE_ZONES];
+uint32_t Profile_Start[PROFILE_ZONES];
+static const char *Names[PROFILE_ZONES];
+
+//------------Profile_Init------------
+// Start the cycle counter and clear all zones.
+// Input: none
+// Output: none
+void Profile_Init(void){int i, j;
+  PROFILE_START();              // start counting core clock cycles
+  for(i=0; i<PROFILE_ZONES; i++){
+    Profile_Zones[i].count = 0;
+    Profile_Zones[i].min = 0xFFFFFFFF;
+    Profile_Zones[i].max = 0;
+    Profile_Zones[i].total = 0;
+    for(j=0; j<PROFILE_BUCKETS; j++){
+      Profile_Zones[i].histogram[j] = 0;
+    }
+    Names[i] = 0;
+  }
+}
+
+//------------Profile_Name------------
+// Give a zone a name for Profile_Dump().
+// Input: zone 0 to PROFILE_ZONES-1
+//        name is a string that stays allocated
+// Output: none
+void Profile_Name(uint32_t zone, const char *name){
+  if(zone < PROFILE_ZONES){
+    Names[zone] = name;
+  }
+}
+
+//------------Profile_Record------------
+// Add one measurement to a zone.  Called by PROFILE_END.
+// Input: zone 0 to PROFILE_ZONES-1
+//        cycles is the measured time (units of core clock cycles)
+// Output: none
+void Profile_Record(uint32_t zone, uint32_t cycles){
+  struct ProfileZone *pt = &Profile_Zones[zone];
+  uint32_t bucket = 0;
+  uint32_t n = cycles>>1;
+  while((n > 0)&&(bucket < PROFILE_BUCKETS-1)){  // floor(log2(cycles))
+    n = n>>1;
+    bucket = bucket + 1;
+  }
+  pt->count = pt->count + 1;
+  pt->total = pt->total + cycles;
+  if(cycles < pt->min){
+    pt->min = cycles;
+  }
+  if(cycles > pt->max){
+    pt->max = cycles;
+  }
+  pt->histogram[bucket] = pt->histogram[bucket] + 1;
+}
+
+//------------Profile_Dump------------
+// Send the zones that have been measured over EUSCIA0 as
+// comma separated text.  For each zone one line has the
+// statistics and a second line the histogram, where
+// bucket b counts times from 2^b to 2^(b+1)-1 cycles.
+// zone,name,count,min,mean,max
+// Input: none
+// Output: none
+// Assumes: EUSCIA0_Init() has been called
+void Profile_Dump(void){int i, j, last;
+  EUSCIA0_OutString("zone,name,count,min,mean,max");
+  EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+  for(i=0; i<PROFILE_ZONES; i++){
+    if(Profile_Zones[i].count){
+      EUSCIA0_OutUDec(i);                    EUSCIA0_OutChar(',');
+      EUSCIA0_OutString(Names[i] ? (char *)Names[i] : "");  EUSCIA0_OutChar(',');
+      EUSCIA0_OutUDec(Profile_Zones[i].count); EUSCIA0_OutChar(',');
+      EUSCIA0_OutUDec(Profile_Zones[i].min);   EUSCIA0_OutChar(',');
+      EUSCIA0_OutUDec(Profile_Zones[i].total/Profile_Zones[i].count); EUSCIA0_OutChar(',');
+      EUSCIA0_OutUDec(Profile_Zones[i].max);   EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+      last = 0;
+      for(j=0; j<PROFILE_BUCKETS; j++){
+        if(Profile_Zones[i].histogram[j]){
+          last = j;
+        }
+      }
+      for(j=0; j<=last; j++){
+        EUSCIA0_OutUDec(Profile_Zones[i].histogram[j]);
+        EUSCIA0_OutChar((j == last) ? CR : ',');
+      }
+      EUSCIA0_OutChar(LF);
+    }
+  }
+}
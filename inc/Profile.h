@@ -0,0 +1,156 @@
+/**
+ * @file      Profile.h
+ * @brief     Cycle-accurate profiling of code zones
+ * @details   Wrap code in PROFILE_BEGIN(zone) and PROFILE_END(zone)
+ * to measure it with the Cortex-M4 DWT cycle counter.  Each zone
+ * keeps its count, minimum, maximum, total and a log2 histogram of
+ * cycles in RAM, and Profile_Dump() sends them over EUSCIA0.<br>
+ * PROFILE_BEGIN is one load and one store, and PROFILE_END adds a
+ * call of about 20 cycles, so zones can stay in competition
+ * builds.  Define PROFILE_OFF before including this file to
+ * remove them.  A simulator build can define PROFILE_CYCLES() and
+ * PROFILE_START() to use its own cycle counter instead of the DWT.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/**
+ * \brief Number of zones
+ */
+#define PROFILE_ZONES   8
+/**
+ * \brief Number of log2 histogram buckets, the last one also counts longer times
+ */
+#define PROFILE_BUCKETS 24
+
+/**
+ * \brief Statistics kept for each zone
+ */
+struct ProfileZone{
+  uint32_t count;     /**< number of measurements */
+  uint32_t min;       /**< shortest time (units of core clock cycles) */
+  uint32_t max;       /**< longest time (units of core clock cycles) */
+  uint32_t total;     /**< sum of times, wraps after 89 s at 48 MHz (units of core clock cycles) */
+  uint32_t histogram[PROFILE_BUCKETS]; /**< bucket b counts times from 2^b to 2^(b+1)-1 cycles */
+};
+
+extern struct ProfileZone Profile_Zones[PROFILE_ZONES];
+extern uint32_t Profile_Start[PROFILE_ZONES];
+
+#ifndef PROFILE_CYCLES
+/**
+ * \brief Read the DWT cycle counter, DWT->CYCCNT
+ */
+#define PROFILE_CYCLES() (*((volatile uint32_t *)0xE0001004))
+#endif
+
+#ifndef PROFILE_START
+/**
+ * \brief Enable the trace block (DEMCR TRCENA) then clear and start the DWT cycle counter
+ */
+#define PROFILE_START() do{ \
+  (*((volatile uint32_t *)0xE000EDFC)) |= 0x01000000; \
+  (*((volatile uint32_t *)0xE0001004)) = 0; \
+  (*((volatile uint32_t *)0xE0001000)) |= 0x00000001; \
+}while(0)
+#endif
+
+#ifndef PROFILE_OFF
+/**
+ * \brief Start timing a zone, 0 to PROFILE_ZONES-1
+ */
+#define PROFILE_BEGIN(zone) (Profile_Start[zone] = PROFILE_CYCLES())
+/**
+ * \brief Stop timing a zone and record the time
+ */
+#define PROFILE_END(zone)   Profile_Record(zone, PROFILE_CYCLES() - Profile_Start[zone])
+#else
+#define PROFILE_BEGIN(zone)
+#define PROFILE_END(zone)
+#endif
+
+/**
+ * Enable the DWT cycle counter and clear all zones.
+ * @param none
+ * @return none
+ * @brief  Initialize the profiler
+ */
+void Profile_Init(void);
+
+/**
+ * Give a zone a name for Profile_Dump().
+ * @param zone 0 to PROFILE_ZONES-1
+ * @param name is a string that stays allocated
+ * @return none
+ * @brief  Name a zone
+ */
+void Profile_Name(uint32_t zone, const char *name);
+
+/**
+ * Add one measurement to a zone.  Called by PROFILE_END.
+ * @param zone 0 to PROFILE_ZONES-1
+ * @param cycles is the measured time (units of core clock cycles)
+ * @return none
+ * @note  Each zone should be used by only one interrupt level
+ * @brief  Record a zone time
+ */
+void Profile_Record(uint32_t zone, uint32_t cycles);
+
+/**
+ * Send the zones that have been measured over EUSCIA0 as
+ * comma separated text.  For each zone one line has the
+ * statistics (zone,name,count,min,mean,max) and a second
+ * line the histogram.
+ * @param none
+ * @return none
+ * @note  Assumes EUSCIA0_Init() has been called
+ * @brief  Send profile results
+ */
+void Profile_Dump(void);
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,185 @@
+// Recorder.c
+// Runs on MSP432
+// Flight recorder: a RAM ring buffer of the most recent
+// control loop ticks that is frozen and saved to flash when
+// the robot bumps into something or reaches the finish, and
+// dumped over EUSCIA0 later.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+// Flash sector at RECORDER_ADDR
+//   entry 0     header: time = MAGIC, data = reason, position = number of ticks
+//   entry 1..n  ticks, oldest first
+
+#include <stdint.h>
+#include "../inc/Clock.h"
+#include "../inc/FlashProgram.h"
+#include "../inc/Motor.h"
+#include "../inc/Tachometer.h"
+#include "../inc/EUSCIA0.h"
+#include "../inc/Recorder.h"
+
+#define MAGIC  0x43455246           // "FREC"
+
+static struct RecorderEntry Ring[RECORDER_SIZE];
+static uint32_t Put;                // index of next entry to write
+static uint32_t Count;              // number of valid entries
+static uint8_t Frozen;              // 1 after Recorder_Save()
+
+//------------Recorder_Init------------
+// Empty the ring buffer and start recording.
+// Input: none
+// Output: none
+void Recorder_Init(void){
+  Put = 0;
+  Count = 0;
+  Frozen = 0;
+}
+
+//------------Recorder_Log------------
+// Record one tick in the ring buffer, overwriting the
+// oldest tick when the ring is full.
+// Input: data      sensor byte from Reflectance_Read()
+//        position  line position from Reflectance_Position()
+//        flag      maze decision or path letter
+// Output: none
+void Recorder_Log(uint8_t data, int32_t position, uint8_t flag){
+  struct RecorderEntry *pt;
+  uint16_t leftTach, rightTach;
+  enum TachDirection leftDir, rightDir;
+  int32_t leftSteps, rightSteps;
+  if(Frozen){
+    return;
+  }
+  pt = &Ring[Put];
+  pt->time = Clock_Now_us();
+  pt->data = data;
+  pt->flag = flag;
+  pt->position = position;
+  Motor_GetDuty(&pt->leftDuty, &pt->rightDuty);
+  Tachometer_Get(&leftTach, &leftDir, &leftSteps, &rightTach, &rightDir, &rightSteps);
+  pt->leftSteps = leftSteps;
+  pt->rightSteps = rightSteps;
+  Put = Put + 1;
+  if(Put == RECORDER_SIZE){
+    Put = 0;
+  }
+  if(Count < RECORDER_SIZE){
+    Count = Count + 1;
+  }
+}
+
+//------------Recorder_Save------------
+// Freeze the recording and write it to flash, oldest tick
+// first, behind a one-entry header.  The ring is stored in
+// two bursts: from the oldest entry to the end of the
+// array, then from the start of the array to the newest.
+// Input: reason  RECORDER_BUMP or RECORDER_FINISH
+// Output: 'NOERROR' if successful, 'ERROR' if fail
+int Recorder_Save(uint8_t reason){
+  struct RecorderEntry header;
+  uint32_t addr, first, n1, n2, words;
+  if(Frozen){
+    return NOERROR;                 // keep the first failure
+  }
+  Frozen = 1;
+  header.time = MAGIC;
+  header.data = reason;
+  header.flag = 0;
+  header.position = Count;
+  header.leftDuty = header.rightDuty = 0;
+  header.leftSteps = header.rightSteps = 0;
+  if(Flash_Erase(RECORDER_ADDR) != NOERROR){
+    return ERROR;
+  }
+  if(Flash_WriteBulk((uint32_t *)&header, RECORDER_ADDR, 4) != 4){
+    return ERROR;
+  }
+  if(Count < RECORDER_SIZE){
+    first = 0;                      // ring never wrapped
+    n1 = Count;
+    n2 = 0;
+  } else{
+    first = Put;                    // oldest entry is overwritten next
+    n1 = RECORDER_SIZE - Put;
+    n2 = Put;
+  }
+  addr = RECORDER_ADDR + sizeof(struct RecorderEntry);
+  words = n1*sizeof(struct RecorderEntry)/4;
+  if(Flash_WriteBulk((uint32_t *)&Ring[first], addr, words) != words){
+    return ERROR;
+  }
+  addr = addr + 4*words;
+  words = n2*sizeof(struct RecorderEntry)/4;
+  if((words > 0) && (Flash_WriteBulk((uint32_t *)&Ring[0], addr, words) != words)){
+    return ERROR;
+  }
+  return NOERROR;
+}
+
+//------------Recorder_Dump------------
+// Send the recording saved in flash over EUSCIA0 as comma
+// separated text, one tick per line, oldest first.
+// us,data,flag,position,leftDuty,rightDuty,leftSteps,rightSteps
+// Input: none
+// Output: number of ticks sent, 0 if nothing saved
+int Recorder_Dump(void){
+  const struct RecorderEntry *pt = (const struct RecorderEntry *)RECORDER_ADDR;
+  int i, n;
+  if((pt->time != MAGIC) || (pt->position > RECORDER_SIZE)){
+    return 0;
+  }
+  n = pt->position;
+  EUSCIA0_OutString((pt->data == RECORDER_BUMP) ? "bump" : "finish");
+  EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+  EUSCIA0_OutString("us,data,flag,position,leftDuty,rightDuty,leftSteps,rightSteps");
+  EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+  for(i=1; i<=n; i=i+1){
+    EUSCIA0_OutUDec(pt[i].time);      EUSCIA0_OutChar(',');
+    EUSCIA0_OutUHex2(pt[i].data);     EUSCIA0_OutChar(',');
+    EUSCIA0_OutUDec(pt[i].flag);      EUSCIA0_OutChar(',');
+    EUSCIA0_OutSDec(pt[i].position);  EUSCIA0_OutChar(',');
+    EUSCIA0_OutSDec(pt[i].leftDuty);  EUSCIA0_OutChar(',');
+    EUSCIA0_OutSDec(pt[i].rightDuty); EUSCIA0_OutChar(',');
+    EUSCIA0_OutSDec(pt[i].leftSteps); EUSCIA0_OutChar(',');
+    EUSCIA0_OutSDec(pt[i].rightSteps); EUSCIA0_OutChar(CR); EUSCIA0_OutChar(LF);
+  }
+  return n;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file      Recorder.h
+ * @brief     Flight recorder of the most recent control loop ticks
+ * @details   Keeps the last RECORDER_SIZE ticks of the line
+ * follower (time, sensor byte, position, motor duty cycles, maze
+ * flag, and tachometer steps) in a RAM ring buffer.  Logging a
+ * tick is a handful of loads and stores, so it can stay on in
+ * competition builds.<br>
+ * When the robot bumps into something or reaches the finish, the
+ * ring is frozen and written to one 4 KB flash sector with burst
+ * programming.  It can be dumped over EUSCIA0 after a reset.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef RECORDER_H_
+#define RECORDER_H_
+
+/**
+ * \brief Flash sector holding the saved recording, 4 KB aligned in Bank 1
+ */
+#define RECORDER_ADDR  0x0003D000
+/**
+ * \brief Number of ticks kept; one 16-byte header plus the ring fill one sector
+ */
+#define RECORDER_SIZE  255
+
+/**
+ * \brief Why the recording was frozen
+ */
+#define RECORDER_BUMP    1  /**< bump switch hit */
+#define RECORDER_FINISH  2  /**< finish marker 0xDB seen */
+
+/**
+ * \brief One tick of the control loop, 16 bytes
+ */
+struct RecorderEntry{
+  uint32_t time;       /**< Clock_Now_us() when logged (units of us) */
+  uint8_t  data;       /**< Reflectance_Read() result */
+  uint8_t  flag;       /**< maze decision (exploring) or path letter (replaying) */
+  int16_t  position;   /**< Reflectance_Position() in 0.1mm */
+  int16_t  leftDuty;   /**< left wheel duty, negative if backward */
+  int16_t  rightDuty;  /**< right wheel duty, negative if backward */
+  int16_t  leftSteps;  /**< left tachometer steps (low 16 bits) */
+  int16_t  rightSteps; /**< right tachometer steps (low 16 bits) */
+};
+
+/**
+ * Empty the ring buffer and start recording.
+ * @param none
+ * @return none
+ * @brief  Initialize the flight recorder
+ */
+void Recorder_Init(void);
+
+/**
+ * Record one tick.  The motor duty cycles and tachometer
+ * steps are read here.  Does nothing once frozen.
+ * @param data      sensor byte from Reflectance_Read(), or wall bits in a wall maze
+ * @param position  line position from Reflectance_Position(), or wall centring error
+ * @param flag      maze decision or path letter
+ * @return none
+ * @note Assumes Tachometer_Init() and Clock_Init48MHz() have been called
+ * @brief  Add a tick to the flight recorder
+ */
+void Recorder_Log(uint8_t data, int32_t position, uint8_t flag);
+
+/**
+ * Stop recording and write the ring buffer, oldest tick
+ * first, to the flash sector at RECORDER_ADDR.  Only the
+ * first call after Recorder_Init() does anything, so the
+ * recording of the first failure is kept.
+ * @param reason  RECORDER_BUMP or RECORDER_FINISH
+ * @return 'NOERROR' if successful, 'ERROR' if the flash could not be written
+ * @note The robot should be stopped; erasing the sector takes tens of ms.
+ * @brief  Freeze the recording and save it to flash
+ */
+int Recorder_Save(uint8_t reason);
+
+/**
+ * Send the recording saved in flash over EUSCIA0 as comma
+ * separated text, one tick per line, oldest first.
+ * @param none
+ * @return number of ticks sent, 0 if nothing has been saved
+ * @note Assumes EUSCIA0_Init() has been called
+ * @brief  Dump the saved recording
+ */
+int Recorder_Dump(void);
+
+#endif /* RECORDER_H_ */
@@ -156,7 +156,11 @@ int32_t Reflectance_Position(uint8_t data){
 // Output: none
 // Assumes: Reflectance_Init() has been called
 void Reflectance_Start(void){
-    // write this as part of Lab 10
+    P5->OUT |= 0x08;      // turn on 8 IR LEDs
+    P7->DIR = 0xFF;       // make P7.7-P7.0 out
+    P7->OUT = 0xFF;       // prime for measurement
+    Clock_Delay1us(10);   // wait 10 us
+    P7->DIR = 0x00;       // make P7.7-P7.0 in
 }
 
 
@@ -169,7 +173,9 @@ void Reflectance_Start(void){
 // Assumes: Reflectance_Init() has been called
 // Assumes: Reflectance_Start() was called 1 ms ago
 uint8_t Reflectance_End(void){
-    // write this as part of Lab 10
- return 0; // replace this line
+uint8_t result;
+    result = (P7->IN & 0xFF); // convert input to digital
+    P5->OUT &= ~0x08;     // turn off 8 IR LEDs
+  return result;
 }
 
@@ -0,0 +1,229 @@
+// Scheduler.c
+// Runs on MSP432
+// Cooperative scheduler of fixed-rate tasks.  SysTick
+// interrupts at a fixed tick and releases the tasks that are
+// due; the main loop runs the released tasks one at a time,
+// highest priority first, and keeps overrun and execution
+// time statistics for each task.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Scheduler.h"
+
+struct task{
+  void (*run)(void);               // user function, 0 if the slot is free
+  uint32_t period;                 // ticks between releases
+  uint32_t countdown;              // ticks until the next release
+  uint32_t priority;               // 0 is the highest
+  volatile uint32_t pending;       // released but not yet run
+  struct SchedulerStats stats;
+};
+static struct task Tasks[SCHEDULER_TASKS];
+static volatile uint32_t Ticks;    // number of SysTick interrupts
+static void (*TickHook)(void) = 0; // run in the SysTick ISR on every tick
+
+//------------Scheduler_Init------------
+// Remove all tasks and start SysTick interrupts at the
+// scheduler tick.
+// Input: period is the tick in bus cycles, 2 to 2^24 (48000 is 1 ms at 48 MHz)
+//        priority of SysTick 0 (high) to 7 (low)
+// Output: none
+void Scheduler_Init(uint32_t period, uint32_t priority){int i;
+  SysTick->CTRL = 0;               // 1) disable SysTick during setup
+  for(i=0; i<SCHEDULER_TASKS; i++){
+    Tasks[i].run = 0;
+  }
+  Ticks = 0;
+  TickHook = 0;
+  SysTick->LOAD = period - 1;      // 2) reload value sets period
+  SysTick->VAL = 0;                // 3) any write to current clears it
+  SCB->SHP[11] = priority<<5;      // set priority into top 3 bits of 8-bit register
+  SysTick->CTRL = 0x00000007;      // 4) enable SysTick with core clock and interrupts
+}
+
+//------------Scheduler_AddTask------------
+// Add a task that runs every period ticks.  The first
+// release is phase ticks from now, so tasks with the same
+// period can be spread over different ticks.
+// Input: task is the user function
+//        period ticks between runs, at least 1
+//        phase ticks before the first run, 0 to run on the next tick
+//        priority 0 (highest) to 255, for tasks released on the same tick
+// Output: task number 0 to SCHEDULER_TASKS-1, or -1 if there is no room
+int Scheduler_AddTask(void(*task)(void), uint32_t period, uint32_t phase, uint32_t priority){
+  int i; long sr;
+  if((task == 0) || (period == 0)){
+    return -1;
+  }
+  for(i=0; i<SCHEDULER_TASKS; i++){
+    if(Tasks[i].run == 0){
+      sr = StartCritical();
+      Tasks[i].period = period;
+      Tasks[i].countdown = phase + 1;
+      Tasks[i].priority = priority;
+      Tasks[i].pending = 0;
+      Tasks[i].stats.runs = 0;
+      Tasks[i].stats.overruns = 0;
+      Tasks[i].stats.lastTime = 0;
+      Tasks[i].stats.maxTime = 0;
+      Tasks[i].stats.totalTime = 0;
+      Tasks[i].run = task;         // last, so the ISR sees a complete task
+      EndCritical(sr);
+      return i;
+    }
+  }
+  return -1;
+}
+
+//------------Scheduler_RemoveTask------------
+// Stop running a task and free its slot.
+// Input: id is the task number from Scheduler_AddTask()
+// Output: none
+void Scheduler_RemoveTask(int id){
+  if((id >= 0) && (id < SCHEDULER_TASKS)){
+    Tasks[id].run = 0;
+  }
+}
+
+void SysTick_Handler(void){int i;
+  Ticks = Ticks + 1;
+  for(i=0; i<SCHEDULER_TASKS; i++){
+    if(Tasks[i].run){
+      Tasks[i].countdown = Tasks[i].countdown - 1;
+      if(Tasks[i].countdown == 0){
+        Tasks[i].countdown = Tasks[i].period;
+        if(Tasks[i].pending){      // last release has not finished
+          Tasks[i].stats.overruns = Tasks[i].stats.overruns + 1;
+        }
+        Tasks[i].pending = 1;
+      }
+    }
+  }
+  if(TickHook){
+    (*TickHook)();
+  }
+}
+
+//------------Scheduler_OnTick------------
+// Run a function in the SysTick ISR on every tick,
+// for example TimerWheel_Tick().
+// Input: hook is the function, 0 for none
+// Output: none
+void Scheduler_OnTick(void(*hook)(void)){
+  TickHook = hook;
+}
+
+//------------Scheduler_Dispatch------------
+// Run the highest priority task that has been released,
+// and measure how long it takes.  Call this over and over
+// from the main loop.
+// Input: none
+// Output: 1 if a task was run, 0 if no task was ready
+int Scheduler_Dispatch(void){
+  int i, best = -1;
+  uint32_t start, time;
+  for(i=0; i<SCHEDULER_TASKS; i++){
+    if(Tasks[i].run && Tasks[i].pending){
+      if((best < 0) || (Tasks[i].priority < Tasks[best].priority)){
+        best = i;
+      }
+    }
+  }
+  if(best < 0){
+    return 0;
+  }
+  start = Clock_Now_us();
+  (*Tasks[best].run)();
+  time = Clock_Now_us() - start;
+  Tasks[best].pending = 0;         // cleared after, so a release while running is an overrun
+  Tasks[best].stats.runs = Tasks[best].stats.runs + 1;
+  Tasks[best].stats.lastTime = time;
+  Tasks[best].stats.totalTime = Tasks[best].stats.totalTime + time;
+  if(time > Tasks[best].stats.maxTime){
+    Tasks[best].stats.maxTime = time;
+  }
+  return 1;
+}
+
+//------------Scheduler_Sleep------------
+// If no task has been released, sleep until the next
+// interrupt.  Interrupts are disabled while checking, so a
+// release just before sleeping still wakes the processor.
+// Input: none
+// Output: none
+void Scheduler_Sleep(void){
+  int i; long sr;
+  sr = StartCritical();
+  for(i=0; i<SCHEDULER_TASKS; i++){
+    if(Tasks[i].run && Tasks[i].pending){
+      EndCritical(sr);
+      return;
+    }
+  }
+  Clock_Sleep();                   // wakes on a pending interrupt
+  EndCritical(sr);                 // which runs now
+}
+
+//------------Scheduler_GetStats------------
+// Copy the statistics of one task.
+// Input: id is the task number from Scheduler_AddTask()
+//        stats is a pointer to store the statistics
+// Output: 0 if successful, -1 if there is no such task
+int Scheduler_GetStats(int id, struct SchedulerStats *stats){long sr;
+  if((id < 0) || (id >= SCHEDULER_TASKS) || (Tasks[id].run == 0)){
+    return -1;
+  }
+  sr = StartCritical();
+  *stats = Tasks[id].stats;
+  EndCritical(sr);
+  return 0;
+}
+
+//------------Scheduler_Ticks------------
+// Return the number of ticks since Scheduler_Init().
+// Input: none
+// Output: ticks
+uint32_t Scheduler_Ticks(void){
+  return Ticks;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file      Scheduler.h
+ * @brief     Cooperative scheduler of fixed-rate tasks
+ * @details   SysTick interrupts at a fixed tick.  Each task is
+ * registered with a period and a phase offset in ticks and a
+ * priority, and the SysTick ISR releases the tasks that are
+ * due.  The main loop calls Scheduler_Dispatch(), which runs
+ * the released task with the highest priority to completion.
+ * So sensor reading, control, logging and the display can each
+ * run at their own rate on one timer.<br>
+ * A task released again before its last release has finished
+ * counts as an overrun.  The time each task takes is measured
+ * with Clock_Now_us().
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/**
+ * \brief Maximum number of tasks
+ */
+#define SCHEDULER_TASKS 8
+
+/**
+ * \brief Statistics kept for each task
+ */
+struct SchedulerStats{
+  uint32_t runs;      /**< number of times the task has run */
+  uint32_t overruns;  /**< releases that came before the last one finished */
+  uint32_t lastTime;  /**< execution time of the last run (units us) */
+  uint32_t maxTime;   /**< longest execution time (units us) */
+  uint32_t totalTime; /**< sum of execution times, divide by runs for the mean (units us) */
+};
+
+/**
+ * Remove all tasks and start SysTick interrupts at the
+ * scheduler tick.
+ * @param period is the tick in bus cycles, 2 to 2^24 (48000 is 1 ms at 48 MHz)
+ * @param priority of SysTick 0 (high) to 7 (low)
+ * @return none
+ * @note  Uses SysTick, so it cannot be used with SysTick.c or SysTickInts.c
+ * @note  Assumes Clock_Init48MHz() has been called
+ * @note  Interrupts must be enabled in the main program.
+ * @brief  Initialize the scheduler
+ */
+void Scheduler_Init(uint32_t period, uint32_t priority);
+
+/**
+ * Add a task that runs every period ticks.  The first
+ * release is phase ticks from now, so tasks with the same
+ * period can be spread over different ticks.
+ * @param task is the user function
+ * @param period ticks between runs, at least 1
+ * @param phase ticks before the first run, 0 to run on the next tick
+ * @param priority 0 (highest) to 255, for tasks released on the same tick
+ * @return task number 0 to SCHEDULER_TASKS-1, or -1 if there is no room
+ * @brief  Add a periodic task
+ */
+int Scheduler_AddTask(void(*task)(void), uint32_t period, uint32_t phase, uint32_t priority);
+
+/**
+ * Stop running a task and free its slot.
+ * @param id is the task number from Scheduler_AddTask()
+ * @return none
+ * @brief  Remove a task
+ */
+void Scheduler_RemoveTask(int id);
+
+/**
+ * Run a function in the SysTick ISR on every tick, for
+ * example TimerWheel_Tick(), so other timing services can
+ * share the scheduler tick.
+ * @param hook is the function, 0 for none
+ * @return none
+ * @note  Call after Scheduler_Init()
+ * @brief  Run a function on every tick
+ */
+void Scheduler_OnTick(void(*hook)(void));
+
+/**
+ * Run the highest priority task that has been released,
+ * and measure how long it takes.  Call this over and over
+ * from the main loop.
+ * @param none
+ * @return 1 if a task was run, 0 if no task was ready
+ * @brief  Run the next task
+ */
+int Scheduler_Dispatch(void);
+
+/**
+ * If no task has been released, sleep until the next
+ * interrupt.  The main loop is then
+ * while(1){ if(Scheduler_Dispatch() == 0) Scheduler_Sleep(); }
+ * and the processor is idle between ticks.
+ * @param none
+ * @return none
+ * @see Clock_Idle_us()
+ * @brief  Sleep until a task may be ready
+ */
+void Scheduler_Sleep(void);
+
+/**
+ * Copy the statistics of one task.
+ * @param id is the task number from Scheduler_AddTask()
+ * @param stats is a pointer to store the statistics
+ * @return 0 if successful, -1 if there is no such task
+ * @brief  Read task statistics
+ */
+int Scheduler_GetStats(int id, struct SchedulerStats *stats);
+
+/**
+ * Return the number of ticks since Scheduler_Init().
+ * @param none
+ * @return ticks
+ * @brief  Read the scheduler tick count
+ */
+uint32_t Scheduler_Ticks(void);
+
+#endif /* SCHEDULER_H_ */
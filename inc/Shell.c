@@ -0,0 +1,275 @@
+// Shell.c
+// Runs on MSP432
+// Non-blocking command shell on EUSCI_A0 to get, set,
+// list and save a table of tunable parameters.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/EUSCIA0.h"
+#include "../inc/FlashProgram.h"
+#include "../inc/FlashStore.h"
+#include "../inc/Format.h"
+#include "../inc/Shell.h"
+
+#define CR   0x0D
+#define LF   0x0A
+#define BS   0x08
+#define DEL  0x7F
+
+static const struct ShellParam *Table;
+static int Count;                  // number of parameters in Table
+static char Line[SHELL_LINE];      // command being typed
+static int Length;                 // characters in Line
+
+static void newline(void){
+  EUSCIA0_OutChar(CR);
+  EUSCIA0_OutChar(LF);
+}
+static void prompt(void){
+  newline();
+  EUSCIA0_OutChar('>');
+}
+static void outsdec(int32_t n){char buf[FORMAT_SIZE];
+  Format_SDec(buf, n, 0);
+  EUSCIA0_OutString(buf);
+}
+
+// compare a word of the line to a string, 1 if equal
+static int same(const char *word, const char *s){
+  while((*word != ' ') && (*word != 0)){
+    if(*word != *s){
+      return 0;
+    }
+    word++; s++;
+  }
+  return *s == 0;
+}
+// skip to the start of the next word, 0 if there is none
+static const char *next(const char *pt){
+  while((*pt != ' ') && (*pt != 0)){
+    pt++;
+  }
+  while(*pt == ' '){
+    pt++;
+  }
+  return *pt ? pt : 0;
+}
+// find a parameter by name, -1 if none
+static int find(const char *word){int i;
+  for(i=0; i<Count; i++){
+    if(same(word, Table[i].name)){
+      return i;
+    }
+  }
+  return -1;
+}
+// signed decimal number, 1 if the word is one
+static int number(const char *word, int32_t *n){int32_t sign = 1, v = 0;
+  if(*word == '-'){
+    sign = -1;
+    word++;
+  }
+  if((*word < '0') || (*word > '9')){
+    return 0;
+  }
+  while((*word >= '0') && (*word <= '9')){
+    if(v > (INT32_MAX - (*word - '0'))/10){
+      return 0;                    // too big for 32 bits
+    }
+    v = 10*v + (*word - '0');
+    word++;
+  }
+  if((*word != ' ') && (*word != 0)){
+    return 0;
+  }
+  *n = sign*v;
+  return 1;
+}
+static void show(int i){
+  EUSCIA0_OutString((char *)Table[i].name);
+  EUSCIA0_OutChar('=');
+  outsdec(*Table[i].value);
+}
+static void error(char *why){
+  EUSCIA0_OutString("error: ");
+  EUSCIA0_OutString(why);
+}
+
+// hash of the names in order, saved with the values so a table
+// with parameters added, removed or moved does not take them
+static int32_t signature(const struct ShellParam *table, int n){
+  uint32_t hash = 2166136261;      // FNV-1a
+  const char *pt; int i;
+  for(i=0; i<n; i++){
+    for(pt=table[i].name; *pt; pt++){
+      hash = (hash^(uint8_t)*pt)*16777619;
+    }
+    hash = (hash^' ')*16777619;    // separates the names
+  }
+  return (int32_t)hash;
+}
+
+static void save(void){int i; int32_t values[SHELL_PARAMS+1];
+  values[0] = signature(Table, Count);
+  for(i=0; i<Count; i++){
+    values[i+1] = *Table[i].value;
+  }
+  if(FlashStore_Write(FLASHSTORE_PARAMS, values, 4*(Count+1)) == NOERROR){
+    EUSCIA0_OutString("saved");
+  }else{
+    error("flash");
+  }
+}
+
+static void execute(void){
+  const char *cmd, *arg; int i; int32_t n;
+  cmd = Line;
+  while(*cmd == ' '){
+    cmd++;
+  }
+  if(*cmd == 0){
+    return;                        // empty line
+  }
+  newline();
+  arg = next(cmd);
+  if(same(cmd, "list")){
+    for(i=0; i<Count; i++){
+      show(i);
+      EUSCIA0_OutString(" (");
+      outsdec(Table[i].min);
+      EUSCIA0_OutString(" to ");
+      outsdec(Table[i].max);
+      EUSCIA0_OutChar(')');
+      if(i < Count-1){
+        newline();
+      }
+    }
+  }else if(same(cmd, "get")){
+    if((arg == 0) || ((i = find(arg)) < 0)){
+      error("unknown parameter");
+    }else{
+      show(i);
+    }
+  }else if(same(cmd, "set")){
+    if((arg == 0) || ((i = find(arg)) < 0)){
+      error("unknown parameter");
+    }else if((next(arg) == 0) || (number(next(arg), &n) == 0)){
+      error("value");
+    }else if((n < Table[i].min) || (n > Table[i].max)){
+      error("out of range");
+    }else{
+      *Table[i].value = n;
+      show(i);
+    }
+  }else if(same(cmd, "save")){
+    save();
+  }else if(same(cmd, "help")){
+    EUSCIA0_OutString("list, get <name>, set <name> <value>, save");
+  }else{
+    error("unknown command, try help");
+  }
+}
+
+//------------Shell_Init------------
+// Start the shell on a table of parameters, replacing
+// the defaults with values saved in flash if they were
+// saved from a table with the same names in the same
+// order, and each is in range.
+// Input: table is an array of parameters kept by the caller
+//        n is the number of parameters, 1 to SHELL_PARAMS
+// Output: none
+void Shell_Init(const struct ShellParam *table, int n){
+  int i; int32_t values[SHELL_PARAMS+1];
+  if((n < 1) || (n > SHELL_PARAMS)){
+    return;                        // invalid input
+  }
+  Table = table;
+  Count = n;
+  Length = 0;
+  if((FlashStore_Read(FLASHSTORE_PARAMS, values, sizeof(values)) == 4*(n+1)) &&
+     (values[0] == signature(table, n))){
+    for(i=0; i<n; i++){
+      if((values[i+1] < table[i].min) || (values[i+1] > table[i].max)){
+        break;
+      }
+    }
+    if(i == n){
+      for(i=0; i<n; i++){
+        *table[i].value = values[i+1];
+      }
+    }
+  }
+  prompt();
+}
+
+//------------Shell_Run------------
+// Handle the characters received since the last call.
+// Returns without waiting when the FIFO is empty.
+// Input: none
+// Output: 1 if a command was run, 0 if not
+int Shell_Run(void){char letter; int ran = 0;
+  if(Count == 0){
+    return 0;                      // Shell_Init not called
+  }
+  while((letter = EUSCIA0_InCharNonBlock()) != 0){
+    if((letter == CR) || (letter == LF)){
+      if(Length){
+        Line[Length] = 0;
+        execute();
+        Length = 0;
+        ran = 1;
+        prompt();
+      }
+    }else if((letter == BS) || (letter == DEL)){
+      if(Length){
+        Length = Length - 1;
+        EUSCIA0_OutChar(BS);
+        EUSCIA0_OutChar(' ');
+        EUSCIA0_OutChar(BS);
+      }
+    }else if((letter >= ' ') && (Length < SHELL_LINE-1)){
+      Line[Length] = letter;
+      Length = Length + 1;
+      EUSCIA0_OutChar(letter);
+    }
+  }
+  return ran;
+}
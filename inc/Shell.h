@@ -0,0 +1,109 @@
+/**
+ * @file      Shell.h
+ * @brief     Non-blocking command shell for tuning parameters
+ * @details   A command line on EUSCI_A0 to read and change a table
+ * of named parameters in RAM while the robot sits between runs.
+ * The EUSCI_A0 receive interrupt puts characters in a FIFO, and
+ * Shell_Run() handles whatever has arrived and returns at once,
+ * so it can be called from any loop.  The control code reads the
+ * parameters at run time, so a change takes effect on the next
+ * run without reflashing.  Commands, ended with Enter:<br>
+ * list               show every parameter and its range<br>
+ * get &lt;name&gt;         show one parameter<br>
+ * set &lt;name&gt; &lt;value&gt; change one parameter<br>
+ * save               keep the values in flash<br>
+ * help               show the commands
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+/**
+ * \brief Maximum number of parameters, so the values and the signature of
+ * their names fit in one flash record
+ */
+#define SHELL_PARAMS 31
+
+/**
+ * \brief Maximum length of a command line
+ */
+#define SHELL_LINE   40
+
+/**
+ * \brief One tunable parameter
+ */
+struct ShellParam{
+  const char *name;    /**< name typed in commands, no spaces */
+  int32_t *value;      /**< variable the control code reads */
+  int32_t min;         /**< smallest value allowed */
+  int32_t max;         /**< largest value allowed */
+};
+
+/**
+ * Start the shell on a table of parameters.  Values saved in
+ * flash by an earlier save command replace the defaults, as
+ * long as they were saved from a table with the same names in
+ * the same order and each value is in range.
+ * @param table is an array of parameters, kept by the caller
+ * @param n is the number of parameters, 1 to SHELL_PARAMS
+ * @return none
+ * @note   EUSCIA0_Init() and FlashStore_Init() must be called first
+ * @brief  Initialize the command shell
+ */
+void Shell_Init(const struct ShellParam *table, int n);
+
+/**
+ * Handle the characters received since the last call,
+ * echoing them and running each completed command.
+ * Never waits for input.
+ * @param  none
+ * @return 1 if a command was run, 0 if not
+ * @brief  Run the command shell
+ */
+int Shell_Run(void);
+
+#endif /* SHELL_H_ */
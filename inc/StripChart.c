@@ -0,0 +1,113 @@
+// StripChart.c
+// Runs on MSP432
+// Scrolling strip chart of the line sensor position and
+// the left/right motor duty cycles on the Nokia5110 LCD.
+// The chart sweeps left to right like an oscilloscope:
+// only the newest column and a blank cursor column are
+// sent each update, so the display keeps up with the
+// control loop while the robot drives.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "../inc/Nokia5110.h"
+#include "../inc/StripChart.h"
+
+#define CHARTW       84    // columns on the LCD
+#define POSCENTER    11    // row of position 0
+#define DUTYCENTER   35    // row of duty 0
+#define HALFSPAN     11    // rows above and below each center
+#define DIVIDER      23    // row separating the two plots
+#define POSMAX      332    // largest position in 0.1mm
+#define DUTYMAX   14998    // largest duty cycle
+
+static uint8_t Column;     // next column to draw, 0 to 83
+
+// Private helper: set one pixel in a 6-byte column
+static void setrow(uint8_t col[6], int32_t row){
+  col[row>>3] |= 1<<(row&0x07);
+}
+
+// Private helper: scale value (-max to +max) to a row
+// offset (-HALFSPAN to +HALFSPAN), clipping the input
+static int32_t scale(int32_t value, int32_t max){
+  if(value > max) value = max;
+  if(value < -max) value = -max;
+  return (value*HALFSPAN)/max;
+}
+
+//------------StripChart_Init------------
+// Clear the LCD and start plotting at the left edge.
+// Input: none
+// Output: none
+// Assumes: Nokia5110_Init() has been called
+void StripChart_Init(void){
+  Nokia5110_Clear();
+  Column = 0;
+}
+
+//------------StripChart_Plot------------
+// Plot one new column of the strip chart and move the
+// cursor one column to the right, wrapping at the right
+// edge.  The column after the new one is blanked (except
+// the divider) so the oldest data is easy to see.
+// Input: position  line position in 0.1mm (-332 to +332)
+//        leftDuty  left wheel duty cycle (-14,998 to 14,998)
+//        rightDuty right wheel duty cycle (-14,998 to 14,998)
+// Output: none
+void StripChart_Plot(int32_t position, int32_t leftDuty, int32_t rightDuty){
+  uint8_t col[6] = {0, 0, 0, 0, 0, 0};
+  setrow(col, DIVIDER);
+  if((Column&0x03) == 0){             // dotted zero lines
+    setrow(col, POSCENTER);
+    setrow(col, DUTYCENTER);
+  }
+  setrow(col, POSCENTER + scale(position, POSMAX));      // left is up
+  setrow(col, DUTYCENTER - scale(leftDuty, DUTYMAX));    // forward is up
+  setrow(col, DUTYCENTER - scale(rightDuty, DUTYMAX));
+  Nokia5110_OutColumn(Column, col);
+  Column = Column + 1;
+  if(Column >= CHARTW){
+    Column = 0;
+  }
+  col[0] = col[1] = col[3] = col[4] = col[5] = 0;
+  col[2] = 1<<(DIVIDER&0x07);         // blank cursor keeps the divider
+  Nokia5110_OutColumn(Column, col);
+}
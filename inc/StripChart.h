@@ -0,0 +1,86 @@
+/**
+ * @file      StripChart.h
+ * @brief     Scrolling strip chart of line sensor position and motor duty on the Nokia5110
+ * @details   Plots Reflectance_Position() and the left/right
+ * motor duty cycles as a sweeping strip chart while the robot
+ * drives, so the line follower can be tuned without a cable.<br>
+ * Each call draws only the newest column.  A circular column
+ * index walks across the screen and a blank cursor column marks
+ * the oldest data, so nothing is shifted and each update sends
+ * just two 6-byte columns over SPI.<br>
+ * Rows 0 to 22: position, -332 (left) at the top to +332 (right) at the bottom<br>
+ * Row  23: divider<br>
+ * Rows 24 to 46: duty cycles, +14,998 at the top to -14,998 at the bottom<br>
+ * Dotted lines mark position 0 and duty 0.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef STRIPCHART_H_
+#define STRIPCHART_H_
+
+/**
+ * Clear the LCD and start plotting at the left edge.
+ * @param none
+ * @return none
+ * @note Assumes Nokia5110_Init() has been called
+ * @brief  Initialize the strip chart
+ */
+void StripChart_Init(void);
+
+/**
+ * Plot one new column of the strip chart and move the
+ * cursor one column to the right, wrapping at the right
+ * edge.  Values outside the ranges are clipped.
+ * @param position  line position in 0.1mm (-332 to +332), see Reflectance_Position()
+ * @param leftDuty  left wheel duty cycle (-14,998 to 14,998), see Motor_GetDuty()
+ * @param rightDuty right wheel duty cycle (-14,998 to 14,998), see Motor_GetDuty()
+ * @return none
+ * @note Sends 12 bytes to the LCD; fast enough to call at 50 Hz or more
+ * @brief  Add one sample to the strip chart
+ */
+void StripChart_Plot(int32_t position, int32_t leftDuty, int32_t rightDuty);
+
+#endif /* STRIPCHART_H_ */
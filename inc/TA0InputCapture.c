@@ -47,8 +47,15 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Timers.h"
 
 void (*CaptureTask)(uint16_t time);// user function
+static int Timer = -1;             // Timer A0 from Timers_Request()
+
+static void capture0(void){
+  TIMER_A0->CCTL[0] &= ~0x0001;             // acknowledge capture/compare interrupt 0
+  (*CaptureTask)(TIMER_A0->CCR[0]);         // execute user task
+}
 
 //------------TimerCapture_Init------------
 // Initialize Timer A0 in edge time mode to request interrupts on
@@ -57,7 +64,14 @@ void (*CaptureTask)(uint16_t time);// user function
 // Input: task is a pointer to a user function called when edge occurs
 //             parameter is 16-bit up-counting timer value when edge occurred
 // Output: none
+// Note: does nothing if another driver holds Timer A0
 void TimerA0Capture_Init(void(*task)(uint16_t time)){
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA0, TIMERS_CAPTURE, &capture0, 0);
+    if(Timer < 0){
+      return;                      // Timer A0 is in use
+    }
+  }
   CaptureTask = task;              // user function
   // initialize P7.3 and make it input (P7.3 TA0CCP0)
   P7->SEL0 |= 0x08;
@@ -100,8 +114,3 @@ void TimerA0Capture_Init(void(*task)(uint16_t time)){
   // bit1=0,           interrupt disable (no interrupt on rollover)
   // bit0=0,           clear interrupt pending
 }
-
-void TA0_0_IRQHandler(void){
-  TIMER_A0->CCTL[0] &= ~0x0001;             // acknowledge capture/compare interrupt 0
-  (*CaptureTask)(TIMER_A0->CCR[0]);         // execute user task
-}
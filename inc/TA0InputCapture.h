@@ -64,7 +64,8 @@ policies, either expressed or implied, of the FreeBSD Project.
  * @param task is a pointer to a user function called when edge occurs<br>
  *        parameter is 16-bit up-counting timer value when edge occurred (units of 0.083 usec)
  * @return none
- * @note  Assumes low-speed subsystem master clock is 12 MHz
+ * @note  Assumes low-speed subsystem master clock is 12 MHz<br>
+ *        Does nothing if another driver holds Timer A0, see Timers.h
  * @brief  Initialize Timer A0
  */
 void TimerA0Capture_Init(void(*task)(uint16_t time));
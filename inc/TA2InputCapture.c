@@ -47,10 +47,17 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "../inc/CortexM.h"
+#include "../inc/Timers.h"
 #include "msp.h"
 
 void ta2dummy(uint16_t t){};       // dummy function
 void (*CaptureTask2)(uint16_t time) = ta2dummy;// user function
+static int Timer = -1;             // Timer A2 from Timers_Request()
+
+static void capture1(void){
+  TIMER_A2->CCTL[1] &= ~0x0001;    // acknowledge capture/compare interrupt 1
+  (*CaptureTask2)(TIMER_A2->CCR[1]);// execute user task
+}
 
 //------------TimerA2Capture_Init------------
 // Initialize Timer A2 in edge time mode to request interrupts on
@@ -59,8 +66,16 @@ void (*CaptureTask2)(uint16_t time) = ta2dummy;// user function
 // Input: task is a pointer to a user function called when edge occurs
 //             parameter is 16-bit up-counting timer value when edge occurred (units of 0.083 usec)
 // Output: none
+// Note: does nothing if another driver holds Timer A2
 void TimerA2Capture_Init(void(*task)(uint16_t time)){long sr;
   sr = StartCritical();
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA2, TIMERS_CAPTURE, 0, &capture1);
+    if(Timer < 0){
+      EndCritical(sr);
+      return;                      // Timer A2 is in use
+    }
+  }
   CaptureTask2 = task;             // user function
   // initialize P5.6 and make it both edges (P5.6 TA2CCP1)
   P5->SEL0 |= 0x40;
@@ -104,8 +119,3 @@ void TimerA2Capture_Init(void(*task)(uint16_t time)){long sr;
   TIMER_A2->CTL |= 0x0024;         // reset and start Timer A2 in continuous up mode
   EndCritical(sr);
 }
-
-void TA2_N_IRQHandler(void){
-  TIMER_A2->CCTL[1] &= ~0x0001;    // acknowledge capture/compare interrupt 1
-  (*CaptureTask2)(TIMER_A2->CCR[1]);// execute user task
-}
@@ -48,11 +48,24 @@ policies, either expressed or implied, of the FreeBSD Project.
 // external signal connected to P10.4 (TA3CCP0) (trigger on rising edge)
 
 #include <stdint.h>
+#include "../inc/CortexM.h"
+#include "../inc/Timers.h"
 #include "msp.h"
 
 void ta3dummy(uint16_t t){};       // dummy function
 void (*CaptureTask0)(uint16_t time) = ta3dummy;// user function
 void (*CaptureTask2)(uint16_t time) = ta3dummy;// user function
+static int Timer = -1;             // Timer A3 from Timers_Request()
+
+static void capture0(void){
+  TIMER_A3->CCTL[0] &= ~0x0001;    // acknowledge capture/compare interrupt 0
+  (*CaptureTask0)(TIMER_A3->CCR[0]);// execute user task
+}
+
+static void capture2(void){
+  TIMER_A3->CCTL[2] &= ~0x0001;    // acknowledge capture/compare interrupt 2
+  (*CaptureTask2)(TIMER_A3->CCR[2]);// execute user task
+}
 
 //------------TimerA3Capture_Init------------
 // Initialize Timer A3 in edge time mode to request interrupts on
@@ -65,15 +78,62 @@ void (*CaptureTask2)(uint16_t time) = ta3dummy;// user function
 //              parameter is 16-bit up-counting timer value when P8.2 (TA3CCP2) edge occurred (units of 0.083 usec)
 // Output: none
 // Assumes: low-speed subsystem master clock is 12 MHz
-void TimerA3Capture_Init(void(*task0)(uint16_t time), void(*task2)(uint16_t time)){
-  // write this as part of lab 16
+// Note: does nothing if another driver holds Timer A3
+void TimerA3Capture_Init(void(*task0)(uint16_t time), void(*task2)(uint16_t time)){long sr;
+  sr = StartCritical();
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA3, TIMERS_CAPTURE, &capture0, &capture2);
+    if(Timer < 0){
+      EndCritical(sr);
+      return;                      // Timer A3 is in use
+    }
+  }
+  CaptureTask0 = task0;            // user function
+  CaptureTask2 = task2;            // user function
+  // initialize P10.4 and make it rising edge (P10.4 TA3CCP0)
+  P10->SEL0 |= 0x10;
+  P10->SEL1 &= ~0x10;              // configure P10.4 as TA3CCP0
+  P10->DIR &= ~0x10;               // make P10.4 in
+  // initialize P8.2 and make it rising edge (P8.2 TA3CCP2)
+  P8->SEL0 |= 0x04;
+  P8->SEL1 &= ~0x04;               // configure P8.2 as TA3CCP2
+  P8->DIR &= ~0x04;                // make P8.2 in
+  TIMER_A3->CTL &= ~0x0030;        // halt Timer A3
+  // bits15-10=XXXXXX, reserved
+  // bits9-8=10,       clock source to SMCLK
+  // bits7-6=00,       input clock divider /1
+  // bits5-4=00,       stop mode
+  // bit3=X,           reserved
+  // bit2=0,           set this bit to clear
+  // bit1=0,           interrupt disable
+  // bit0=0,           clear interrupt pending
+  TIMER_A3->CTL = 0x0200;
+  // bits15-14=01,     capture on rising edge
+  // bits13-12=00,     capture/compare input on CCI0A or CCI2A
+  // bit11=1,          synchronous capture source
+  // bit10=X,          synchronized capture/compare input
+  // bit9=X,           reserved
+  // bit8=1,           capture mode
+  // bits7-5=XXX,      output mode
+  // bit4=1,           enable capture/compare interrupt
+  // bit3=X,           read capture/compare input from here
+  // bit2=X,           output this value in output mode 0
+  // bit1=X,           capture overflow status
+  // bit0=0,           clear capture/compare interrupt pending
+  TIMER_A3->CCTL[0] = 0x4910;
+  TIMER_A3->CCTL[2] = 0x4910;
+  TIMER_A3->EX0 &= ~0x0007;        // configure for input clock divider /1
+  NVIC->IP[3] = (NVIC->IP[3]&0x0000FFFF)|0x40400000; // priority 2
+// interrupts enabled in the main program after all devices initialized
+  NVIC->ISER[0] = 0x0000C000;      // enable interrupts 14 and 15 in NVIC
+  // bits15-10=XXXXXX, reserved
+  // bits9-8=10,       clock source to SMCLK
+  // bits7-6=00,       input clock divider /1
+  // bits5-4=10,       continuous count up mode
+  // bit3=X,           reserved
+  // bit2=1,           set this bit to clear
+  // bit1=0,           interrupt disable (no interrupt on rollover)
+  // bit0=0,           clear interrupt pending
+  TIMER_A3->CTL |= 0x0024;         // reset and start Timer A3 in continuous up mode
+  EndCritical(sr);
 }
-
-void TA3_0_IRQHandler(void){
-  // write this as part of lab 16
-}
-
-void TA3_N_IRQHandler(void){
-  // write this as part of lab 16
-}
-
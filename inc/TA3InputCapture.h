@@ -67,7 +67,8 @@ policies, either expressed or implied, of the FreeBSD Project.
  * @param task2 is a pointer to a user function called when P8.2 (TA3CCP2) edge occurs<br>
  *        parameter is 16-bit up-counting timer value when P8.2 (TA3CCP2) edge occurred (units of 0.083 usec)
  * @return none
- * @note  Assumes low-speed subsystem master clock is 12 MHz
+ * @note  Assumes low-speed subsystem master clock is 12 MHz<br>
+ *        Does nothing if another driver holds Timer A3, see Timers.h
  * @brief  Initialize Timer A3
  */
 void TimerA3Capture_Init(void(*task0)(uint16_t time), void(*task2)(uint16_t time));
@@ -46,6 +46,8 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include "..\inc\CortexM.h"
 #include "msp.h"
 #include "..\inc\TExaS.h"
+#include "..\inc\Format.h"
+#include "..\inc\Timers.h"
 // bit 7 must be set, so TExaSdisplay can separate characters from LA data
 char volatile LogicData; // this is the 7-bit value sent to display
 void LogicAnalyzer(void){        // called 10k/sec
@@ -129,75 +131,31 @@ void Scope(void){          // called 10k/sec
   }
 }
 void (*PeriodicTask2)(void);   // user function
-/* Version 1 uses Timer A3
+static int TExaSTimer = -1;     // timer from Timers_Request()
+static void runtask(void){
+  (*PeriodicTask2)();              // execute user task
+}
+// Run task at freq on any free timer, which Timers_Periodic()
+// acknowledges.  So TExaS works alongside the tachometer on
+// Timer A3, PWM on Timer A0, and the clock on Timer32 2.
+static void periodic(void(*task)(void), uint32_t freq, uint8_t priority){
+  PeriodicTask2 = task;            // user function
+  if(TExaSTimer < 0){
+    TExaSTimer = Timers_Request(TIMERS_ANY, TIMERS_PERIODIC, &runtask, 0);
+  }
+  Timers_Periodic(TExaSTimer, freq, priority); // does nothing if no timer is free
+}
+
 // ------------PeriodicTask2_Init------------
 // Activate an interrupt to run a user task periodically.
 // Give it a priority 0 to 6 with lower numbers
 // signifying higher priority.  Equal priority is
 // handled sequentially.
 // Input:  task is a pointer to a user function
-//         subs is subsystem clock frequency in Hz
 //         freq is number of interrupts per second
 //           1 Hz to 10 kHz
 //         priority is a number 0 to 6
 // Output: none
-
-void PeriodicTask2_Init(void(*task)(void), uint32_t freq, uint8_t priority){
-  if((freq == 0) || (freq > 10000)){
-    return;                        // invalid input
-  }
-  if(priority > 6){
-    priority = 6;
-  }
-  PeriodicTask2 = task;            // user function
-  // ***************** TimerA3 initialization *****************
-  TIMER_A3->CTL &= ~0x0030;               // halt Timer A3
-  // bits15-10=XXXXXX, reserved
-  // bits9-8=10,       clock source to SMCLK (12,000,000 Hz after BSP_Clock_InitFastest() called)
-  // bits7-6=00,       input clock divider /1
-  // bits5-4=00,       stop mode
-  // bit3=X,           reserved
-  // bit2=0,           set this bit to clear
-  // bit1=0,           no interrupt on timer
-  // bit0=0,           clear interrupt pending
-  TIMER_A3->CTL = 0x0200;
-  TIMER_A3->EX0 &= ~0x0007;               // configure for input clock divider /1
-  // bits15-14=00,     no capture mode
-  // bits13-12=XX,     capture/compare input select
-  // bit11=X,          synchronize capture source
-  // bit10=X,          synchronized capture/compare input
-  // bit9=X,           reserved
-  // bit8=0,           compare mode
-  // bits7-5=XXX,      output mode
-  // bit4=1,           enable capture/compare interrupt on CCIFG
-  // bit3=X,           read capture/compare input from here
-  // bit2=0,           output this value in output mode 0
-  // bit1=X,           capture overflow status
-  // bit0=0,           clear capture/compare interrupt pending
-  TIMER_A3->CCTL[0] = 0x0010;
-  TIMER_A3->CCR[0] = (12000000/freq - 1);      // compare match value
-// interrupts enabled in the main program after all devices initialized
-  NVIC->IP[3] = (NVIC->IP[3]&0xFF00FFFF)|(priority<<21); // priority
-  NVIC->ISER[0] = 0x00004000;         // enable interrupt 14 in NVIC
-  TIMER_A3->CTL |= 0x0014;            // reset and start Timer A3 in up mode
-}
-
-void TA3_0_IRQHandler(void){
-  TIMER_A3->CCTL[0] &= ~0x0001;    // acknowledge capture/compare interrupt 0
-  (*PeriodicTask2)();              // execute user task
-}
-
-// ------------PeriodicTask2_Stop------------
-// Deactivate the interrupt running a user task periodically.
-// Input: none
-// Output: none
-void PeriodicTask2_Stop(void){
-  TIMER_A3->CCTL[0] &= ~0x0001;    // clear capture/compare interrupt pending
-  NVIC->ICER[0] = 0x00004000;      // disable interrupt 14 in NVIC
-}
-
-*/
-// Version 2 uses Timer32 module 1
 void PeriodicTask2_Init(void(*task)(void), uint32_t freq, uint8_t priority){
   if((freq == 0) || (freq > 10000)){
     return;                        // invalid input
@@ -205,33 +163,14 @@ void PeriodicTask2_Init(void(*task)(void), uint32_t freq, uint8_t priority){
   if(priority > 6){
     priority = 6;
   }
-  PeriodicTask2 = task;            // user function
-  TIMER32_1->LOAD = (48000000/freq - 1); // timer reload value
-  TIMER32_1->INTCLR = 0x00000001;    // clear Timer32 Timer 1 interrupt
-  // bits31-8=X...X,   reserved
-  // bit7=1,           timer enable
-  // bit6=1,           timer in periodic mode
-  // bit5=1,           interrupt enable
-  // bit4=X,           reserved
-  // bits3-2=00,       /1 input clock divider
-  // bit1=1,           32-bit counter
-  // bit0=0,           wrapping mode
-  TIMER32_1->CONTROL = 0x000000E2;
-// interrupts enabled in the main program after all devices initialized
-  NVIC->IP[6] = (NVIC->IP[6]&0xFFFF00FF)|(priority<<13);
-  NVIC->ISER[0] = 0x02000000;   // enable interrupt 25 in NVIC
-}
-void T32_INT1_IRQHandler(void){
-  TIMER32_1->INTCLR = 0x00000001;  // acknowledge Timer32 Timer 1 interrupt
-  (*PeriodicTask2)();              // execute user task
+  periodic(task, freq, priority);
 }
 // ------------PeriodicTask2_Stop------------
 // Deactivate the interrupt running a user task periodically.
 // Input: none
 // Output: none
 void PeriodicTask2_Stop(void){
-  TIMER32_1->INTCLR = 0x00000001; // clear capture/compare interrupt pending
-  NVIC->ICER[0] = 0x02000000;     // disable interrupt 25 in NVIC
+  Timers_Stop(TExaSTimer);         // keep the timer for the next start
 }
 
 //------------UART_Init------------
@@ -518,10 +457,439 @@ void TExaS_Init(enum TExaSmode mode){
   }
 }
 
+// Capture mode: sample port bits into RAM at up to 200 kHz,
+// stop a set number of samples after a trigger, then upload
+// the whole buffer in one burst.  Uses the same timer as
+// the logic analyzer, so only one of them can run at a time.
+// Edge mode shares the RAM and keeps only the changes, and
+// block scope mode shares it for 14-bit ADC samples.
+struct edge{
+  uint16_t run;                    // samples since the previous edge
+  uint8_t value;                   // port bits from this edge on
+};
+#define EDGES (TEXAS_CAPTURESIZE/sizeof(struct edge))
+static union{
+  uint8_t samples[TEXAS_CAPTURESIZE];
+  struct edge edges[EDGES];
+  uint16_t scope[TEXAS_SCOPESIZE];
+}CaptureRam;
+#define TExaS_CaptureBuf CaptureRam.samples
+static uint32_t EdgeRun;           // samples since the last edge
+static uint32_t EdgeCount;         // edges recorded
+static volatile uint8_t *CapturePort;  // port input register
+static uint8_t CaptureMask;        // bits of the port to keep
+static uint8_t CapturePattern;     // trigger when (sample&CaptureTrigMask) becomes this
+static uint8_t CaptureTrigMask;
+static uint8_t CaptureLast;        // previous sample
+static uint32_t CaptureFreq;       // samples per second
+static uint32_t CaptureIndex;      // next place to write
+static uint32_t CaptureCount;      // samples written since armed
+static uint32_t CapturePre;        // samples kept before the trigger
+static uint32_t CapturePost;       // samples still to take after the trigger
+static uint32_t CaptureTrigger;    // index of the trigger sample
+static volatile int CaptureState;  // 0 armed, 1 triggered, 2 done
+void Capture(void){uint8_t data;
+  data = (*CapturePort)&CaptureMask;
+  TExaS_CaptureBuf[CaptureIndex] = data;
+  if(CaptureState == 0){
+    CaptureCount = CaptureCount + 1;
+    if((CaptureCount > CapturePre) && ((data&CaptureTrigMask) == CapturePattern) &&
+       (((CaptureLast&CaptureTrigMask) != CapturePattern) || (CaptureTrigMask == 0))){
+      CaptureState = 1;            // trigger, keep the pre-trigger samples before it
+      CaptureTrigger = CaptureIndex;
+    }
+  }else{
+    CapturePost = CapturePost - 1;
+    if(CapturePost == 0){
+      CaptureState = 2;
+      PeriodicTask2_Stop();
+    }
+  }
+  CaptureLast = data;
+  CaptureIndex = (CaptureIndex + 1)&(TEXAS_CAPTURESIZE-1);
+}
+
+// ************TExaS_CaptureInit*****************
+// Start sampling port bits into RAM.  The capture
+// triggers when the bits in trigmask change to pattern,
+// after at least pre samples have been taken, and it
+// stops TEXAS_CAPTURESIZE-pre samples after the trigger.
+// Inputs:  port is the input register, e.g., &P7->IN
+//          mask is the bits to keep
+//          freq is samples per second, 1 Hz to 200 kHz
+//          pattern is the trigger value of the bits in trigmask
+//          trigmask is the bits to trigger on, 0 to trigger at once
+//          pre is the number of samples before the trigger, less than TEXAS_CAPTURESIZE
+// Outputs: none
+void TExaS_CaptureInit(volatile uint8_t *port, uint8_t mask, uint32_t freq,
+                       uint8_t pattern, uint8_t trigmask, uint32_t pre){
+  if((freq == 0) || (freq > 200000) || (pre >= TEXAS_CAPTURESIZE)){
+    return;                        // invalid input
+  }
+  PeriodicTask2_Stop();
+  UART_Init();
+  CapturePort = port;
+  CaptureMask = mask;
+  CapturePattern = pattern&trigmask;
+  CaptureTrigMask = trigmask;
+  CaptureLast = ~CapturePattern;   // a match on the first samples is an edge
+  CaptureFreq = freq;
+  CaptureIndex = 0;
+  CaptureCount = 0;
+  CapturePre = pre;
+  CapturePost = TEXAS_CAPTURESIZE - pre - 1;
+  CaptureState = 0;
+  if(CapturePost == 0){
+    CapturePost = 1;
+  }
+  periodic(&Capture, freq, 1);      // priority 1, above the drivers
+}
+
+void EdgeCapture(void){uint8_t data;
+  data = (*CapturePort)&CaptureMask;
+  EdgeRun = EdgeRun + 1;
+  if((data != CaptureLast) || (EdgeRun == 0xFFFF)){ // change, or the run is as long as fits
+    CaptureRam.edges[EdgeCount].run = EdgeRun;
+    CaptureRam.edges[EdgeCount].value = data;
+    EdgeCount = EdgeCount + 1;
+    EdgeRun = 0;
+    CaptureLast = data;
+    if(EdgeCount == EDGES){        // full
+      CaptureState = 2;
+      PeriodicTask2_Stop();
+    }
+  }
+}
+
+// ************TExaS_EdgeInit*****************
+// Start recording changes of port bits into RAM.  The
+// bits are sampled at freq, but only a change is stored,
+// as the number of samples since the last change and the
+// new value, so a capture lasts much longer than one of
+// TExaS_CaptureInit() at the same rate.  It stops when
+// the RAM is full or when TExaS_EdgeUpload() is called.
+// Inputs:  port is the input register, e.g., &P7->IN
+//          mask is the bits to watch
+//          freq is samples per second, 1 Hz to 200 kHz, dividing 1,000,000
+// Outputs: none
+void TExaS_EdgeInit(volatile uint8_t *port, uint8_t mask, uint32_t freq){
+  if((freq == 0) || (freq > 200000) || (1000000%freq)){
+    return;                        // invalid input
+  }
+  PeriodicTask2_Stop();
+  UART_Init();
+  CapturePort = port;
+  CaptureMask = mask;
+  CaptureFreq = freq;
+  CaptureLast = (*port)&mask;      // the first edge is the starting value
+  CaptureRam.edges[0].run = 0;
+  CaptureRam.edges[0].value = CaptureLast;
+  EdgeCount = 1;
+  EdgeRun = 0;
+  CaptureState = 1;
+  periodic(&EdgeCapture, freq, 1);  // priority 1, above the drivers
+}
+
+static uint16_t ScopeLevel;        // trigger level, 0 to 16383
+static int ScopeSlope;             // 1 rising, -1 falling, 0 at once
+static uint32_t ScopeDecimation;   // conversions averaged per sample
+static uint32_t ScopeN;            // conversions in ScopeSum
+static uint32_t ScopeSum;
+static uint16_t ScopeLast;         // previous sample
+static uint8_t ADCSaved;           // 1 while the ADC setup below is borrowed
+static uint32_t SavedCTL0, SavedCTL1, SavedMCTL6, SavedIER0, SavedIER1;
+
+// give the ADC back as it was before TExaS_ScopeBlockInit()
+static void restoreadc(void){
+  if(ADCSaved == 0){
+    return;
+  }
+  ADCSaved = 0;
+  ADC14->CTL0 &= ~0x00000002;      // ADC14ENC = 0 to allow programming
+  while(ADC14->CTL0&0x00010000){}; // wait for BUSY to be zero
+  ADC14->CTL1 = SavedCTL1;
+  ADC14->MCTL[6] = SavedMCTL6;
+  ADC14->CLRIFGR0 = 0xFFFFFFFF;    // drop the flags of the scope conversions
+  ADC14->IER0 = SavedIER0;
+  ADC14->IER1 = SavedIER1;
+  ADC14->CTL0 = SavedCTL0&~0x00000003;
+  ADC14->CTL0 |= SavedCTL0&0x00000002; // enable again, the trigger source starts conversions
+}
+
+void ScopeBlock(void){uint32_t data;
+  if((ADC14->IFGR0&0x40) == 0){
+    TExaS_ScopeErrLostData = TExaS_ScopeErrLostData + 1;
+    return;                        // still converting, freq is too high
+  }
+  data = TEXASADCRESULTLOC;        // finished during the last period
+  ADC14->CTL0 |= 0x00000001;       // start the next conversion
+  ScopeSum = ScopeSum + data;
+  ScopeN = ScopeN + 1;
+  if(ScopeN < ScopeDecimation){
+    return;
+  }
+  data = ScopeSum/ScopeDecimation;
+  ScopeSum = 0;
+  ScopeN = 0;
+  CaptureRam.scope[CaptureIndex] = data;
+  if(CaptureState == 0){
+    CaptureCount = CaptureCount + 1;
+    if((CaptureCount > CapturePre) &&
+       ((ScopeSlope == 0) ||
+        ((ScopeSlope > 0) && (ScopeLast < ScopeLevel) && (data >= ScopeLevel)) ||
+        ((ScopeSlope < 0) && (ScopeLast > ScopeLevel) && (data <= ScopeLevel)))){
+      CaptureState = 1;            // trigger, keep the pre-trigger samples before it
+      CaptureTrigger = CaptureIndex;
+    }
+  }else{
+    CapturePost = CapturePost - 1;
+    if(CapturePost == 0){
+      CaptureState = 2;
+      PeriodicTask2_Stop();
+      restoreadc();
+    }
+  }
+  ScopeLast = data;
+  CaptureIndex = (CaptureIndex + 1)&(TEXAS_SCOPESIZE-1);
+}
+
+// analog mode on the pin of ADC input channel
+static void analogpin(uint32_t channel){uint8_t bit;
+  if(channel < 6){                 // A5-A0 are P5.0-P5.5
+    bit = 0x20>>channel;
+    P5->SEL0 |= bit; P5->SEL1 |= bit;
+  }else if(channel < 14){          // A13-A6 are P4.0-P4.7
+    bit = 0x80>>(channel-6);
+    P4->SEL0 |= bit; P4->SEL1 |= bit;
+  }else if(channel < 16){          // A15-A14 are P6.0-P6.1
+    bit = 0x02>>(channel-14);
+    P6->SEL0 |= bit; P6->SEL1 |= bit;
+  }else if(channel < 18){          // A17-A16 are P9.0-P9.1
+    bit = 0x02>>(channel-16);
+    P9->SEL0 |= bit; P9->SEL1 |= bit;
+  }else{                           // A23-A18 are P8.2-P8.7
+    bit = 0x80>>(channel-18);
+    P8->SEL0 |= bit; P8->SEL1 |= bit;
+  }
+}
+
+// ************TExaS_ScopeBlockInit*****************
+// Sample one ADC channel into RAM with 14-bit resolution.
+// Each timer interrupt reads the conversion started in
+// the previous one and starts the next, so the sampling
+// jitter is just the latency of a priority 1 interrupt.
+// The capture triggers when the signal crosses level in the
+// direction of slope, after at least pre samples have been
+// taken, and stops TEXAS_SCOPESIZE-pre samples after it.
+// The ADC setup of another driver, like the Timer A1 IR
+// sampling, is saved and put back when the capture is done
+// or TExaS_Stop() is called.
+// Inputs:  channel is the ADC input, 0 to 23, e.g., 17 for P9.0/A17
+//          freq is conversions per second, 1 Hz to 200 kHz
+//          decimation is conversions averaged into each sample, 1 or more
+//          level is the trigger level, 0 to 16383
+//          slope is 1 to trigger rising, -1 falling, 0 at once
+//          pre is the number of samples before the trigger, less than TEXAS_SCOPESIZE
+// Outputs: none
+void TExaS_ScopeBlockInit(uint32_t channel, uint32_t freq, uint32_t decimation,
+                          uint16_t level, int slope, uint32_t pre){
+  if((channel > 23) || (freq == 0) || (freq > 200000) || (decimation == 0) ||
+     (pre >= TEXAS_SCOPESIZE)){
+    return;                        // invalid input
+  }
+  PeriodicTask2_Stop();
+  UART_Init();
+  ScopeLevel = level;
+  ScopeSlope = slope;
+  ScopeDecimation = decimation;
+  ScopeN = 0;
+  ScopeSum = 0;
+  ScopeLast = (slope < 0) ? 0 : 16383; // a first sample past the level is not an edge
+  CaptureFreq = freq;
+  CaptureIndex = 0;
+  CaptureCount = 0;
+  CapturePre = pre;
+  CapturePost = TEXAS_SCOPESIZE - pre - 1;
+  CaptureState = 0;
+  if(CapturePost == 0){
+    CapturePost = 1;
+  }
+  if(ADCSaved == 0){               // keep the setup of the driver that had it
+    SavedCTL0 = ADC14->CTL0;
+    SavedCTL1 = ADC14->CTL1;
+    SavedMCTL6 = ADC14->MCTL[6];
+    SavedIER0 = ADC14->IER0;
+    SavedIER1 = ADC14->IER1;
+    ADCSaved = 1;
+  }
+  ADC14->CTL0 &= ~0x00000002;      // ADC14ENC = 0 to allow programming
+  while(ADC14->CTL0&0x00010000){}; // wait for BUSY to be zero
+  ADC14->CTL0 = 0x04223390;        // single, SMCLK, on, disabled, /1, 32 SHM
+  ADC14->CTL1 = 0x00060030;        // ADC14MEM6, 14-bit, ref on, regular power
+  ADC14->MCTL[6] = 0x00000080|channel; // 0 to 3.3V, end of sequence
+  ADC14->IER0 = 0;
+  ADC14->IER1 = 0;                 // no interrupts
+  analogpin(channel);
+  ADC14->CTL0 |= 0x00000003;       // enable and start the first conversion
+  periodic(&ScopeBlock, freq, 1);   // priority 1, above the drivers
+}
+
+// ************TExaS_CaptureDone*****************
+// Check if the capture has finished
+// Inputs:  none
+// Outputs: 0 waiting for trigger, 1 triggered, 2 done
+int TExaS_CaptureDone(void){
+  return CaptureState;
+}
+
+static void outhex2(uint8_t n){
+  UART_OutChar("0123456789ABCDEF"[n>>4]);
+  UART_OutChar("0123456789ABCDEF"[n&0x0F]);
+}
+static void outudec(uint32_t n){char buf[FORMAT_SIZE]; int i;
+  Format_UDec(buf, n, 0);
+  for(i=0; buf[i]; i++){
+    UART_OutChar(buf[i]);
+  }
+}
+
+// ************TExaS_CaptureUpload*****************
+// Send a finished capture over UART0 in one burst, oldest
+// sample first, as text: a header line
+// capture,<samples per second>,<trigger sample number>
+// and then the samples in hex, 32 per line.
+// Inputs:  none
+// Outputs: 0 if sent, -1 if the capture has not finished
+int TExaS_CaptureUpload(void){uint32_t i, start;
+  if(CaptureState != 2){
+    return -1;
+  }
+  start = CaptureIndex;            // oldest sample
+  UART_OutChar('c'); UART_OutChar('a'); UART_OutChar('p'); UART_OutChar('t');
+  UART_OutChar('u'); UART_OutChar('r'); UART_OutChar('e'); UART_OutChar(',');
+  outudec(CaptureFreq);
+  UART_OutChar(',');
+  outudec((CaptureTrigger - start)&(TEXAS_CAPTURESIZE-1));
+  UART_OutChar(0x0D); UART_OutChar(0x0A);
+  for(i=0; i<TEXAS_CAPTURESIZE; i++){
+    outhex2(TExaS_CaptureBuf[(start + i)&(TEXAS_CAPTURESIZE-1)]);
+    if((i&31) == 31){
+      UART_OutChar(0x0D); UART_OutChar(0x0A);
+    }
+  }
+  return 0;
+}
+
+static void outstring(char *pt){
+  while(*pt){
+    UART_OutChar(*pt);
+    pt++;
+  }
+}
+static void outbits(uint8_t data, uint8_t changed){int b;
+  for(b=0; b<8; b++){
+    if(changed&(1<<b)){
+      UART_OutChar((data&(1<<b)) ? '1' : '0');
+      UART_OutChar('!'+b);         // the identifier of bit b
+      UART_OutChar(0x0A);
+    }
+  }
+}
+
+// ************TExaS_ScopeBlockUpload*****************
+// Send a finished block scope capture over UART0 in one
+// burst, oldest sample first.  A header line
+// scope,<samples per second>,<trigger sample number>,<level>
+// is followed by framed blocks of 32 samples, one per line:
+// $<block number>,<32 samples, 4 hex digits each>*<checksum>
+// The checksum is the 8-bit sum of the sample bytes in hex,
+// so a receiver can find a lost or corrupted block.
+// Inputs:  none
+// Outputs: 0 if sent, -1 if the capture has not finished
+int TExaS_ScopeBlockUpload(void){uint32_t i, start; uint16_t data; uint8_t sum;
+  if((PeriodicTask2 != &ScopeBlock) || (CaptureState != 2)){
+    return -1;
+  }
+  start = CaptureIndex;            // oldest sample
+  outstring("scope,");
+  outudec(CaptureFreq/ScopeDecimation);
+  UART_OutChar(',');
+  outudec((CaptureTrigger - start)&(TEXAS_SCOPESIZE-1));
+  UART_OutChar(',');
+  outudec(ScopeLevel);
+  UART_OutChar(0x0D); UART_OutChar(0x0A);
+  sum = 0;
+  for(i=0; i<TEXAS_SCOPESIZE; i++){
+    if((i&31) == 0){
+      UART_OutChar('$');
+      outudec(i/32);
+      UART_OutChar(',');
+      sum = 0;
+    }
+    data = CaptureRam.scope[(start + i)&(TEXAS_SCOPESIZE-1)];
+    outhex2(data>>8);
+    outhex2(data&0xFF);
+    sum = sum + (data>>8) + (data&0xFF);
+    if((i&31) == 31){
+      UART_OutChar('*');
+      outhex2(sum);
+      UART_OutChar(0x0D); UART_OutChar(0x0A);
+    }
+  }
+  return 0;
+}
+
+// ************TExaS_EdgeUpload*****************
+// Stop an edge capture and send it over UART0 in one
+// burst as a Value Change Dump, which GTKWave opens
+// directly.  Each watched bit is a wire named b0 to b7,
+// and time is in us from the start of the capture.
+// Inputs:  none
+// Outputs: number of edges sent, -1 if no edge capture was started
+int TExaS_EdgeUpload(void){uint32_t i, time, us; uint8_t last; int b;
+  if((PeriodicTask2 != &EdgeCapture) || (CaptureState == 0)){
+    return -1;
+  }
+  PeriodicTask2_Stop();
+  CaptureState = 2;
+  us = 1000000/CaptureFreq;        // us per sample
+  outstring("$timescale 1 us $end\n$scope module port $end\n");
+  for(b=0; b<8; b++){
+    if(CaptureMask&(1<<b)){
+      outstring("$var wire 1 ");
+      UART_OutChar('!'+b);
+      outstring(" b");
+      UART_OutChar('0'+b);
+      outstring(" $end\n");
+    }
+  }
+  outstring("$upscope $end\n$enddefinitions $end\n#0\n");
+  last = CaptureRam.edges[0].value;
+  outbits(last, CaptureMask);
+  time = 0;
+  for(i=1; i<EdgeCount; i++){
+    time = time + CaptureRam.edges[i].run*us;
+    if(CaptureRam.edges[i].value != last){
+      UART_OutChar('#');
+      outudec(time);
+      UART_OutChar(0x0A);
+      outbits(CaptureRam.edges[i].value, CaptureRam.edges[i].value^last);
+      last = CaptureRam.edges[i].value;
+    }
+  }
+  UART_OutChar('#');               // end of the capture
+  outudec(time + EdgeRun*us);
+  UART_OutChar(0x0A);
+  return EdgeCount;
+}
+
 // ************TExaS_Stop*****************
 // Stop the transfer
 // Inputs:  none
 // Outputs: none
 void TExaS_Stop(void){
   PeriodicTask2_Stop();
+  restoreadc();                    // after a block scope capture
+  Timers_Release(TExaSTimer);      // let another driver use the timer
+  TExaSTimer = -1;
 }
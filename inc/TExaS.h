@@ -83,13 +83,156 @@ enum TExaSmode{
  * @note   This module only runs at 48 MHz<br>
  * Uses UART0, EUSCI_A0 to pass data to PC<br>
  * Uses ADC J3.26/P4.4/A9 in scope mode<br>
- * Uses Timer32 periodic interrupts for 10 kHz sampling
+ * Uses a free timer from Timers.h for 10 kHz sampling
  * @warning TExaS_Init must be called before calling any other TExaS functions
  * @brief  Initialize logic analyzer or scope
  * @details   Virtual 7-bit logic analyzer or 8-bit scope sampling J3.26/P4.4/A9
  */
 void TExaS_Init(enum TExaSmode mode);
 
+/**
+ * \brief Number of samples in a capture, must be a power of 2
+ */
+#define TEXAS_CAPTURESIZE 4096
+
+/**
+ * Start sampling port bits into a RAM buffer, much faster than
+ * the logic analyzer can stream them.  The capture triggers
+ * when the bits in trigmask change to pattern, after at least
+ * pre samples have been taken, and stops TEXAS_CAPTURESIZE-pre
+ * samples after the trigger.  For example, trigger on the line
+ * sensors all seeing black with
+ * TExaS_CaptureInit(&P7->IN, 0xFF, 100000, 0xFF, 0xFF, 1024);
+ * or on bump switch 0 being pressed with
+ * TExaS_CaptureInit(&P4->IN, 0xED, 100000, 0x00, 0x01, 2048);
+ *
+ * @param  port is the input register, e.g., &P7->IN
+ * @param  mask is the bits to keep
+ * @param  freq is samples per second, 1 Hz to 200 kHz
+ * @param  pattern is the trigger value of the bits in trigmask
+ * @param  trigmask is the bits to trigger on, 0 to trigger at once
+ * @param  pre is the number of samples before the trigger, less than TEXAS_CAPTURESIZE
+ * @return none
+ *
+ * @note   This module only runs at 48 MHz<br>
+ * Uses a free timer from Timers.h at priority 1, so it replaces TExaS_Init()<br>
+ * At 100 kHz the sampling interrupt takes about a tenth of the processor
+ * @see TExaS_CaptureDone(), TExaS_CaptureUpload()
+ * @brief  Start a triggered capture to RAM
+ */
+void TExaS_CaptureInit(volatile uint8_t *port, uint8_t mask, uint32_t freq,
+                       uint8_t pattern, uint8_t trigmask, uint32_t pre);
+
+/**
+ * Check if the capture has finished
+ *
+ * @param  none
+ * @return 0 waiting for trigger, 1 triggered, 2 done
+ * @brief  Capture status
+ */
+int TExaS_CaptureDone(void);
+
+/**
+ * Send a finished capture over UART0 in one burst, oldest
+ * sample first, as text: a header line
+ * capture,&lt;samples per second&gt;,&lt;trigger sample number&gt;
+ * and then the samples in hex, 32 per line.
+ *
+ * @param  none
+ * @return 0 if sent, -1 if the capture has not finished
+ * @note   Takes about 0.8 s at 115,200 bps
+ * @brief  Upload a capture
+ */
+int TExaS_CaptureUpload(void);
+
+/**
+ * Start recording changes of port bits into RAM.  The bits
+ * are sampled at freq, but only a change is stored, as the
+ * number of samples since the last change and the new value.
+ * Robot signals change rarely, so a capture lasts orders of
+ * magnitude longer than one of TExaS_CaptureInit() at the
+ * same rate.  It stops when 1024 changes have been recorded
+ * or when TExaS_EdgeUpload() is called.
+ *
+ * @param  port is the input register, e.g., &P8->IN for the bump switches
+ * @param  mask is the bits to watch
+ * @param  freq is samples per second, 1 Hz to 200 kHz, dividing 1,000,000
+ * @return none
+ *
+ * @note   Uses a free timer from Timers.h at priority 1, so it replaces TExaS_Init() and TExaS_CaptureInit()
+ * @see TExaS_EdgeUpload()
+ * @brief  Start an edge capture to RAM
+ */
+void TExaS_EdgeInit(volatile uint8_t *port, uint8_t mask, uint32_t freq);
+
+/**
+ * Stop an edge capture and send it over UART0 in one burst
+ * as a Value Change Dump (VCD), so the terminal log opens
+ * directly in GTKWave.  Each watched bit is a wire named b0
+ * to b7, and time is in us from the start of the capture.
+ *
+ * @param  none
+ * @return number of edges sent, -1 if no edge capture was started
+ * @brief  Upload an edge capture as VCD
+ */
+int TExaS_EdgeUpload(void);
+
+/**
+ * \brief Number of 14-bit samples in a block scope capture
+ */
+#define TEXAS_SCOPESIZE (TEXAS_CAPTURESIZE/2)
+
+/**
+ * Sample one ADC channel into RAM with full 14-bit resolution,
+ * much faster than the 10 kHz 8-bit streaming scope.  Each
+ * timer interrupt reads the conversion started in the
+ * previous one and starts the next, and decimation conversions
+ * are averaged into each stored sample.  The capture triggers
+ * when the signal crosses level in the direction of slope,
+ * after at least pre samples have been taken, and stops
+ * TEXAS_SCOPESIZE-pre samples after the trigger.  For example,
+ * the center IR sensor at 50 kHz, triggered rising through 1.65 V,
+ * TExaS_ScopeBlockInit(17, 50000, 1, 8192, 1, 256);
+ * or battery droop through a divider on P4.4/A9 when the motors
+ * start, 10 kHz samples each averaging 4, falling through 2.5 V,
+ * TExaS_ScopeBlockInit(9, 40000, 4, 12412, -1, 512);
+ *
+ * @param  channel is the ADC input, 0 to 23, e.g., 17 for P9.0/A17
+ * @param  freq is conversions per second, 1 Hz to 200 kHz
+ * @param  decimation is conversions averaged into each sample, 1 or more
+ * @param  level is the trigger level, 0 to 16383
+ * @param  slope is 1 to trigger rising, -1 falling, 0 at once
+ * @param  pre is the number of samples before the trigger, less than TEXAS_SCOPESIZE
+ * @return none
+ *
+ * @note   This module only runs at 48 MHz<br>
+ * Uses a free timer from Timers.h at priority 1, so it replaces TExaS_Init() and TExaS_CaptureInit()<br>
+ * Takes over the ADC14.  The setup of the driver that had it, e.g., the Timer A1
+ * IR sampling of ADC0_InitTimerTriggerCh17_12_16(), is saved and put back when
+ * the capture is done or TExaS_Stop() is called.  No IR samples are taken in
+ * between, so code that waits for a new one, like wall_read(), waits until then<br>
+ * TExaS_ScopeErrLostData counts conversions not finished in time
+ * @see TExaS_CaptureDone(), TExaS_ScopeBlockUpload()
+ * @brief  Start a triggered 14-bit ADC capture to RAM
+ */
+void TExaS_ScopeBlockInit(uint32_t channel, uint32_t freq, uint32_t decimation,
+                          uint16_t level, int slope, uint32_t pre);
+
+/**
+ * Send a finished block scope capture over UART0 in one burst,
+ * oldest sample first.  A header line
+ * scope,&lt;samples per second&gt;,&lt;trigger sample number&gt;,&lt;level&gt;
+ * is followed by framed blocks of 32 samples, one per line,
+ * $&lt;block number&gt;,&lt;32 samples, 4 hex digits each&gt;*&lt;checksum&gt;
+ * where the checksum is the 8-bit sum of the sample bytes in hex.
+ *
+ * @param  none
+ * @return 0 if sent, -1 if the capture has not finished
+ * @note   Takes about 0.8 s at 115,200 bps
+ * @brief  Upload a block scope capture
+ */
+int TExaS_ScopeBlockUpload(void);
+
 /**
  * Stop scope or logic analyzer functionality
  *
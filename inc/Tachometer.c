@@ -56,6 +56,7 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "../inc/Clock.h"
 #include "../inc/TA3InputCapture.h"
+#include "../inc/Convert.h"
 #include "msp.h"
 #include "Tachometer.h"
 
@@ -65,10 +66,49 @@ int Tachometer_RightSteps = 0;     // incremented with every step forward; decre
 int Tachometer_LeftSteps = 0;      // incremented with every step forward; decremented with every step backward
 enum TachDirection Tachometer_RightDir = STOPPED;
 enum TachDirection Tachometer_LeftDir = STOPPED;
+uint32_t Tachometer_RightRpm = 0;  // wheel speed from the last period (units rpm)
+uint32_t Tachometer_LeftRpm = 0;   // wheel speed from the last period (units rpm)
+uint32_t Tachometer_RightUs, Tachometer_LeftUs; // Clock_Now_us() at the last edge
+
+#define LONGPERIOD 5000            // us, a 16-bit capture period this long may have wrapped
+#define TIMEOUT  100000            // us without an edge before a wheel reads 0 rpm
+
+// wheel speed from the 16-bit capture period, or from the
+// Clock_Now_us() period when the capture may have wrapped
+// (below about 33 rpm)
+static uint32_t periodToRpm(uint16_t period, uint32_t us){
+  if(us >= LONGPERIOD){
+    return Convert_UsToRpm(us);
+  }
+  return Convert_PeriodToRpm(period);
+}
+
+// the last rpm, but no faster than a wheel that has not
+// moved one step in the time since its last edge
+static uint32_t recentRpm(uint32_t rpm, uint32_t last){
+  uint32_t elapsed, most;
+  if(Clock_Now_us() == 0){
+    return rpm;                      // Clock_Init48MHz() has not started the time
+  }
+  elapsed = Clock_Now_us() - last;
+  if(elapsed >= TIMEOUT){
+    return 0;                        // stalled or stopped
+  }
+  if(elapsed >= LONGPERIOD){
+    most = Convert_UsToRpm(elapsed);
+    if(rpm > most){
+      return most;
+    }
+  }
+  return rpm;
+}
 
 void tachometerRightInt(uint16_t currenttime){
+  uint32_t now = Clock_Now_us();
   Tachometer_FirstRightTime = Tachometer_SecondRightTime;
   Tachometer_SecondRightTime = currenttime;
+  Tachometer_RightRpm = periodToRpm(Tachometer_SecondRightTime - Tachometer_FirstRightTime, now - Tachometer_RightUs);
+  Tachometer_RightUs = now;
   if((P10->IN&0x20) == 0){
     // Encoder B is low, so this is a step backward
     Tachometer_RightSteps = Tachometer_RightSteps - 1;
@@ -81,8 +121,11 @@ void tachometerRightInt(uint16_t currenttime){
 }
 
 void tachometerLeftInt(uint16_t currenttime){
+  uint32_t now = Clock_Now_us();
   Tachometer_FirstLeftTime = Tachometer_SecondLeftTime;
   Tachometer_SecondLeftTime = currenttime;
+  Tachometer_LeftRpm = periodToRpm(Tachometer_SecondLeftTime - Tachometer_FirstLeftTime, now - Tachometer_LeftUs);
+  Tachometer_LeftUs = now;
   if((P9->IN&0x04) == 0){
     // Encoder B is low, so this is a step backward
     Tachometer_LeftSteps = Tachometer_LeftSteps - 1;
@@ -133,3 +176,17 @@ void Tachometer_Get(uint16_t *leftTach, enum TachDirection *leftDir, int32_t *le
   *rightDir = Tachometer_RightDir;
   *rightSteps = Tachometer_RightSteps;
 }
+
+// ------------Tachometer_GetRpm------------
+// Get the most recent wheel speeds, converted from the
+// tachometer periods in the interrupt service routines.
+// A wheel with no edge for a while reads no faster than one
+// step in that time, and 0 after 100 ms, so a stall shows.
+// Input: leftRpm  is pointer to store last measured speed of left wheel (units rpm)
+//        rightRpm is pointer to store last measured speed of right wheel (units rpm)
+// Output: none
+// Assumes: Tachometer_Init() has been called
+void Tachometer_GetRpm(uint32_t *leftRpm, uint32_t *rightRpm){
+  *leftRpm = recentRpm(Tachometer_LeftRpm, Tachometer_LeftUs);
+  *rightRpm = recentRpm(Tachometer_RightRpm, Tachometer_RightUs);
+}
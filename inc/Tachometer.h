@@ -106,4 +106,21 @@ void Tachometer_Init(void);
 void Tachometer_Get(uint16_t *leftTach, enum TachDirection *leftDir, int32_t *leftSteps,
                     uint16_t *rightTach, enum TachDirection *rightDir, int32_t *rightSteps);
 
+/**
+ * Get the most recent wheel speeds.  Each tachometer
+ * period is converted to rpm in the interrupt service
+ * routine with Convert_PeriodToRpm(), which takes the
+ * same time for every period.  Periods over 5 ms, which
+ * wrap the 16-bit capture, are timed with Clock_Now_us().
+ * A wheel with no edge in the time since its last one reads
+ * no faster than one step in that time, and 0 rpm after
+ * 100 ms, so a stopped or stalled wheel reads 0.
+ * @param leftRpm is pointer to store last measured speed of left wheel (units rpm)
+ * @param rightRpm is pointer to store last measured speed of right wheel (units rpm)
+ * @return none
+ * @note Assumes Tachometer_Init() has been called
+ * @brief Get the most recent wheel speeds
+ */
+void Tachometer_GetRpm(uint32_t *leftRpm, uint32_t *rightRpm);
+
 #endif /* TACHOMETER_H_ */
@@ -45,8 +45,15 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/Timer32.h"
+#include "../inc/Timers.h"
 
 void (*PeriodicTask32)(void);   // user function
+static int Timer = -1;          // Timer32 1 from Timers_Request()
+
+static void periodic(void){
+  TIMER32_1->INTCLR = 0x00000001;  // acknowledge Timer32 Timer 1 interrupt
+  (*PeriodicTask32)();               // execute user task
+}
 
 // ***************** Timer32_1_Init ****************
 // Activate Timer32 Timer 1 interrupts to run user task periodically
@@ -57,7 +64,14 @@ void (*PeriodicTask32)(void);   // user function
 //            T32DIV16  for input clock divider /16
 //            T32DIV256 for input clock divider /256
 // Outputs: none
+// Note: does nothing if another driver holds Timer32 1
 void Timer32_Init(void(*task)(void), uint32_t period, enum timer32divider div){
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_T32_1, TIMERS_PERIODIC, &periodic, 0);
+    if(Timer < 0){
+      return;                        // Timer32 1 is in use
+    }
+  }
   PeriodicTask32 = task;             // user function
   TIMER32_1->LOAD = (period - 1);    // timer reload value
   TIMER32_1->INTCLR = 0x00000001;    // clear Timer32 Timer 1 interrupt
@@ -74,8 +88,3 @@ void Timer32_Init(void(*task)(void), uint32_t period, enum timer32divider div){
   NVIC->IP[6] = (NVIC->IP[6]&0xFFFF00FF)|0x00004000; // priority 2
   NVIC->ISER[0] = 0x02000000;         // enable interrupt 25 in NVIC
 }
-
-void T32_INT1_IRQHandler(void){
-  TIMER32_1->INTCLR = 0x00000001;  // acknowledge Timer32 Timer 1 interrupt
-  (*PeriodicTask32)();               // execute user task
-}
@@ -45,16 +45,30 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Timers.h"
 
 
 void (*TimerA0Task)(void);   // user function
+static int Timer = -1;       // Timer A0 from Timers_Request()
+
+static void periodic(void){
+  TIMER_A0->CCTL[0] &= ~0x0001; // acknowledge capture/compare interrupt 0
+  (*TimerA0Task)();             // execute user task
+}
 
 // ***************** TimerA0_Init ****************
 // Activate Timer A0 interrupts to run user task periodically
 // Inputs:  task is a pointer to a user function
 //          period in units (24/SMCLK), 16 bits
 // Outputs: none
+// Note: does nothing if another driver holds Timer A0
 void TimerA0_Init(void(*task)(void), uint16_t period){
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA0, TIMERS_PERIODIC, &periodic, 0);
+    if(Timer < 0){
+      return;                     // Timer A0 is in use
+    }
+  }
   TimerA0Task = task;             // user function
   TIMER_A0->CTL &= ~0x0030;       // halt Timer A0
   // bits15-10=XXXXXX, reserved
@@ -94,10 +108,7 @@ void TimerA0_Init(void(*task)(void), uint16_t period){
 void TimerA0_Stop(void){
   TIMER_A0->CTL &= ~0x0030;       // halt Timer A0
   NVIC->ICER[0] = 0x00000100;     // disable interrupt 8 in NVIC
+  Timers_Release(Timer);          // let another driver use Timer A0
+  Timer = -1;
 }
 
-
-void TA0_0_IRQHandler(void){
-  TIMER_A0->CCTL[0] &= ~0x0001; // acknowledge capture/compare interrupt 0
-  (*TimerA0Task)();             // execute user task
-}
@@ -45,15 +45,28 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Timers.h"
 
 void (*TimerA1Task)(void);   // user function
+static int Timer = -1;       // Timer A1 from Timers_Request()
+
+static void periodic(void){
+ TIMER_A1->CCTL[0] &=  ~0x0001;// write this as part of Lab 13
+}
 
 // ***************** TimerA1_Init ****************
 // Activate Timer A1 interrupts to run user task periodically
 // Inputs:  task is a pointer to a user function
 //          period in units (24/SMCLK), 16 bits
 // Outputs: none
+// Note: does nothing if another driver holds Timer A1
 void TimerA1_Init(void(*task)(void), uint16_t period){
+    if(Timer < 0){
+      Timer = Timers_Request(TIMERS_TA1, TIMERS_PERIODIC, &periodic, 0);
+      if(Timer < 0){
+        return;              // Timer A1 is in use
+      }
+    }
     *TimerA1Task = task;
     TIMER_A1->CTL = 0x0280;
     TIMER_A1->CCTL[0] = 0x0010;
@@ -71,8 +84,3 @@ void TimerA1_Init(void(*task)(void), uint16_t period){
 void TimerA1_Stop(void){
  // write this as part of Lab 13
 }
-
-
-void TA1_0_IRQHandler(void){
- TIMER_A1->CCTL[0] &=  ~0x0001;// write this as part of Lab 13
-}
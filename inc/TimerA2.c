@@ -44,16 +44,30 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Timers.h"
 
 
 void (*TimerA2Task)(void);   // user function
+static int Timer = -1;       // Timer A2 from Timers_Request()
+
+static void periodic(void){
+  TIMER_A2->CCTL[0] &= ~0x0001; // acknowledge capture/compare interrupt 0
+  (*TimerA2Task)();             // execute user task
+}
 
 // ***************** TimerA2_Init ****************
 // Activate Timer A2 interrupts to run user task periodically
 // Inputs:  task is a pointer to a user function
 //          period in units (24/SMCLK), 16 bits
 // Outputs: none
+// Note: does nothing if another driver holds Timer A2
 void TimerA2_Init(void(*task)(void), uint16_t period){
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA2, TIMERS_PERIODIC, &periodic, 0);
+    if(Timer < 0){
+      return;                     // Timer A2 is in use
+    }
+  }
   TimerA2Task = task;             // user function
   TIMER_A2->CTL &= ~0x0030;       // halt Timer A2
   // bits15-10=XXXXXX, reserved
@@ -93,10 +107,7 @@ void TimerA2_Init(void(*task)(void), uint16_t period){
 void TimerA2_Stop(void){
   TIMER_A2->CTL &= ~0x0030;       // halt Timer A2
   NVIC->ICER[0] = 0x00001000;     // disable interrupt 12 in NVIC
+  Timers_Release(Timer);          // let another driver use Timer A2
+  Timer = -1;
 }
 
-
-void TA2_0_IRQHandler(void){
-  TIMER_A2->CCTL[0] &= ~0x0001; // acknowledge capture/compare interrupt 0
-  (*TimerA2Task)();             // execute user task
-}
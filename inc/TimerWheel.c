@@ -0,0 +1,281 @@
+// TimerWheel.c
+// Runs on MSP432
+// Software timers for many concurrent timeouts, all driven
+// by one periodic interrupt.  A two level timer wheel makes
+// starting, cancelling and expiring a timer take constant time
+// no matter how many timers are running.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+// Level 0 has a slot for each of the next 64 ticks.  Level 1 has a
+// slot for each of the next 64 blocks of 64 ticks; a block's timers
+// are moved down to level 0 when the block starts.  A timer further
+// away than level 1 reaches waits in the last level 1 slot and is
+// moved again when that slot comes up.
+
+#include <stdint.h>
+#include "../inc/CortexM.h"
+#include "../inc/TimerWheel.h"
+
+#define SLOTS 64
+#define SLOTBITS 6
+#define IDLE  0                    // not running
+#define WHEEL 1                    // waiting in a wheel slot
+
+static struct TimerWheelTimer *Level0[SLOTS];
+static struct TimerWheelTimer *Level1[SLOTS];
+static struct TimerWheelTimer *Expiring;    // due this tick, taken off one at a time
+static struct TimerWheelTimer *ReadyHead;   // expired deferred timers, oldest first
+static struct TimerWheelTimer **ReadyTail;  // readyNext field of the newest one
+static volatile uint32_t Now;      // ticks since TimerWheel_Init
+
+// add timer to the front of a list, call with interrupts disabled
+static void link(struct TimerWheelTimer **head, struct TimerWheelTimer *timer){
+  timer->next = *head;
+  if(*head){
+    (*head)->pprev = &timer->next;
+  }
+  *head = timer;
+  timer->pprev = head;
+}
+
+// take timer out of its list, call with interrupts disabled
+static void unlink(struct TimerWheelTimer *timer){
+  if(timer->next){
+    timer->next->pprev = timer->pprev;
+  }
+  *timer->pprev = timer->next;
+  timer->state = IDLE;
+}
+
+// put timer in the wheel slot for its expiry time, call with interrupts disabled
+static void insert(struct TimerWheelTimer *timer){
+  uint32_t blocks = (timer->expires>>SLOTBITS) - (Now>>SLOTBITS);
+  if((timer->expires - Now) < SLOTS){
+    link(&Level0[timer->expires&(SLOTS-1)], timer);
+  }else if(blocks < SLOTS){
+    link(&Level1[(timer->expires>>SLOTBITS)&(SLOTS-1)], timer);
+  }else{                           // too far, wait in the last slot
+    link(&Level1[((Now>>SLOTBITS)+SLOTS-1)&(SLOTS-1)], timer);
+  }
+  timer->state = WHEEL;
+}
+
+//------------TimerWheel_Init------------
+// Stop all timers and set the time to zero.
+// Input: none
+// Output: none
+void TimerWheel_Init(void){int i; long sr;
+  sr = StartCritical();
+  for(i=0; i<SLOTS; i++){
+    Level0[i] = 0;
+    Level1[i] = 0;
+  }
+  Expiring = 0;
+  ReadyHead = 0;
+  ReadyTail = &ReadyHead;
+  Now = 0;
+  EndCritical(sr);
+}
+
+//------------TimerWheel_Tick------------
+// Advance time by one tick and expire the timers that are
+// due.  Timers started with TIMERWHEEL_ISR run their task
+// here; the others are queued for TimerWheel_Run().
+// Input: none
+// Output: none
+// Note: call from exactly one periodic interrupt
+void TimerWheel_Tick(void){
+  struct TimerWheelTimer *list, *timer;
+  long sr;
+  sr = StartCritical();            // the main program may be starting timers
+  Now = Now + 1;
+  if((Now&(SLOTS-1)) == 0){        // new block, move its timers down to level 0
+    list = Level1[(Now>>SLOTBITS)&(SLOTS-1)];
+    Level1[(Now>>SLOTBITS)&(SLOTS-1)] = 0;
+    while(list){
+      timer = list;
+      list = list->next;
+      insert(timer);
+    }
+  }
+  Expiring = Level0[Now&(SLOTS-1)];  // due timers stay linked and WHEEL, so a
+  Level0[Now&(SLOTS-1)] = 0;         // task can still cancel or restart them
+  if(Expiring){
+    Expiring->pprev = &Expiring;
+  }
+  while(Expiring){
+    timer = Expiring;
+    unlink(timer);                 // now IDLE
+    if(timer->period){             // periodic, schedule the next expiry first
+      timer->expires = timer->expires + timer->period;
+      insert(timer);
+    }
+    if(timer->flags&TIMERWHEEL_ISR){
+      EndCritical(sr);
+      (*timer->task)();            // the task may start or cancel any timer
+      sr = StartCritical();
+    }else{
+      timer->pending = 1;
+      if(timer->queued == 0){      // wait in the ready list
+        timer->queued = 1;
+        timer->readyNext = 0;
+        *ReadyTail = timer;
+        ReadyTail = &timer->readyNext;
+      }
+    }
+  }
+  EndCritical(sr);
+}
+
+//------------TimerWheel_Start------------
+// Start a timer, or restart it if it is already running.
+// The task runs once delay ticks from now, and then every
+// period ticks if period is not zero.
+// Input: timer is a timer owned by the caller, which must stay allocated while running
+//        task is the user function to run
+//        delay ticks to the first expiry, at least 1
+//        period ticks between later expiries, 0 for a one-shot timer
+//        flags TIMERWHEEL_ISR to run the task in the tick interrupt,
+//              TIMERWHEEL_DEFERRED to run it from TimerWheel_Run()
+// Output: none
+void TimerWheel_Start(struct TimerWheelTimer *timer, void(*task)(void),
+                      uint32_t delay, uint32_t period, uint32_t flags){long sr;
+  if(delay == 0){
+    delay = 1;
+  }
+  sr = StartCritical();
+  if(timer->state != IDLE){
+    unlink(timer);
+  }
+  timer->task = task;
+  timer->delay = delay;
+  timer->period = period;
+  timer->flags = flags;
+  timer->pending = 0;
+  timer->expires = Now + delay;
+  insert(timer);
+  EndCritical(sr);
+}
+
+//------------TimerWheel_Restart------------
+// Start a timer again with the task, delay, period and
+// flags of its last TimerWheel_Start().  Restarting before
+// it expires makes a watchdog.
+// Input: timer that has been started before
+// Output: none
+void TimerWheel_Restart(struct TimerWheelTimer *timer){long sr;
+  sr = StartCritical();
+  if(timer->state != IDLE){
+    unlink(timer);
+  }
+  timer->pending = 0;
+  timer->expires = Now + timer->delay;
+  insert(timer);
+  EndCritical(sr);
+}
+
+//------------TimerWheel_Cancel------------
+// Stop a timer.  A deferred task that has expired but not
+// yet run will not run.  The timer stays in the ready list
+// until TimerWheel_Run() next looks at it.
+// Input: timer to stop
+// Output: none
+void TimerWheel_Cancel(struct TimerWheelTimer *timer){long sr;
+  sr = StartCritical();
+  if(timer->state != IDLE){
+    unlink(timer);
+  }
+  timer->pending = 0;
+  EndCritical(sr);
+}
+
+//------------TimerWheel_Active------------
+// Check if a timer is running or has an expired deferred
+// task waiting to run.
+// Input: timer to check
+// Output: 1 if active, 0 if not
+int TimerWheel_Active(struct TimerWheelTimer *timer){
+  return (timer->state != IDLE) || (timer->pending != 0);
+}
+
+//------------TimerWheel_Run------------
+// Run the tasks of deferred timers that have expired.
+// Call this over and over from the main loop.  A periodic
+// deferred task that expired more than once since it last
+// ran is run once.
+// Input: none
+// Output: number of tasks run
+int TimerWheel_Run(void){
+  struct TimerWheelTimer *timer;
+  void (*task)(void);
+  int n = 0;
+  long sr;
+  while(1){
+    sr = StartCritical();
+    timer = ReadyHead;
+    if(timer == 0){
+      EndCritical(sr);
+      return n;
+    }
+    ReadyHead = timer->readyNext;
+    if(ReadyHead == 0){
+      ReadyTail = &ReadyHead;
+    }
+    timer->queued = 0;
+    if(timer->pending){            // not cancelled since it expired
+      timer->pending = 0;
+      task = timer->task;
+      EndCritical(sr);
+      (*task)();
+      n = n + 1;
+    }else{
+      EndCritical(sr);
+    }
+  }
+}
+
+//------------TimerWheel_Now------------
+// Return the number of ticks since TimerWheel_Init().
+// Input: none
+// Output: ticks
+uint32_t TimerWheel_Now(void){
+  return Now;
+}
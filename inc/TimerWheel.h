@@ -0,0 +1,176 @@
+/**
+ * @file      TimerWheel.h
+ * @brief     Software timers driven by one periodic interrupt
+ * @details   Many concurrent timeouts (bump debounce, echo
+ * timeout, turn watchdog, LED blink, radio retry) share one
+ * periodic interrupt instead of each taking a hardware timer.
+ * The timers sit in a two level timer wheel, so starting,
+ * cancelling and expiring a timer take constant time however
+ * many are running.  Timers can be one-shot or periodic, and
+ * their task can run in the tick interrupt or be deferred to
+ * TimerWheel_Run() in the main loop.<br>
+ * The caller owns each struct TimerWheelTimer, so there is
+ * no fixed limit on the number of timers.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+/**
+ * \brief Run the task in the tick interrupt
+ */
+#define TIMERWHEEL_ISR       1
+/**
+ * \brief Run the task from TimerWheel_Run() in the main loop
+ */
+#define TIMERWHEEL_DEFERRED  0
+
+/**
+ * \brief One software timer, owned by the caller
+ * @note  The fields are private to TimerWheel.c.  Declare timers
+ * as globals or statics so they start out zero.
+ */
+struct TimerWheelTimer{
+  struct TimerWheelTimer *next;       /**< next timer in the same wheel slot */
+  struct TimerWheelTimer **pprev;     /**< the pointer that points to this timer */
+  struct TimerWheelTimer *readyNext;  /**< next expired deferred timer */
+  void (*task)(void);                 /**< user function */
+  uint32_t expires;                   /**< tick of the next expiry */
+  uint32_t delay;                     /**< ticks to the first expiry */
+  uint32_t period;                    /**< ticks between expiries, 0 for one-shot */
+  uint8_t flags;                      /**< TIMERWHEEL_ISR or TIMERWHEEL_DEFERRED */
+  uint8_t state;                      /**< running or not */
+  uint8_t pending;                    /**< expired deferred task not yet run */
+  uint8_t queued;                     /**< in the ready list */
+};
+
+/**
+ * Stop all timers and set the time to zero.
+ * @param none
+ * @return none
+ * @note  Call once before starting any timer
+ * @brief  Initialize the timer wheel
+ */
+void TimerWheel_Init(void);
+
+/**
+ * Advance time by one tick and expire the timers that are
+ * due.  Timers started with TIMERWHEEL_ISR run their task
+ * here; the others are queued for TimerWheel_Run().
+ * @param none
+ * @return none
+ * @note  Call from exactly one periodic interrupt, for example
+ * Scheduler_OnTick(&TimerWheel_Tick) makes the ticks 1 ms with
+ * a 1 ms scheduler
+ * @brief  Tick the timer wheel
+ */
+void TimerWheel_Tick(void);
+
+/**
+ * Start a timer, or restart it if it is already running.
+ * The task runs once delay ticks from now, and then every
+ * period ticks if period is not zero.
+ * @param timer is a timer owned by the caller, which must stay allocated while running
+ * @param task is the user function to run
+ * @param delay ticks to the first expiry, at least 1
+ * @param period ticks between later expiries, 0 for a one-shot timer
+ * @param flags TIMERWHEEL_ISR to run the task in the tick interrupt,
+ *              TIMERWHEEL_DEFERRED to run it from TimerWheel_Run()
+ * @return none
+ * @brief  Start a timer
+ */
+void TimerWheel_Start(struct TimerWheelTimer *timer, void(*task)(void),
+                      uint32_t delay, uint32_t period, uint32_t flags);
+
+/**
+ * Start a timer again with the task, delay, period and
+ * flags of its last TimerWheel_Start().  Restarting before
+ * it expires makes a watchdog.
+ * @param timer that has been started before
+ * @return none
+ * @brief  Restart a timer
+ */
+void TimerWheel_Restart(struct TimerWheelTimer *timer);
+
+/**
+ * Stop a timer.  A deferred task that has expired but not
+ * yet run will not run.
+ * @param timer to stop
+ * @return none
+ * @brief  Cancel a timer
+ */
+void TimerWheel_Cancel(struct TimerWheelTimer *timer);
+
+/**
+ * Check if a timer is running or has an expired deferred
+ * task waiting to run.
+ * @param timer to check
+ * @return 1 if active, 0 if not
+ * @brief  Check a timer
+ */
+int TimerWheel_Active(struct TimerWheelTimer *timer);
+
+/**
+ * Run the tasks of deferred timers that have expired.
+ * Call this over and over from the main loop.  A periodic
+ * deferred task that expired more than once since it last
+ * ran is run once.
+ * @param none
+ * @return number of tasks run
+ * @brief  Run expired deferred tasks
+ */
+int TimerWheel_Run(void);
+
+/**
+ * Return the number of ticks since TimerWheel_Init().
+ * @param none
+ * @return ticks
+ * @brief  Read the timer wheel time
+ */
+uint32_t TimerWheel_Now(void);
+
+#endif /* TIMERWHEEL_H_ */
@@ -0,0 +1,266 @@
+// Timers.c
+// Runs on MSP432
+// Allocate the four Timer_A and two Timer32 modules to
+// drivers and dispatch their interrupts through a table.
+// October 18, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/CortexM.h"
+#include "../inc/Timers.h"
+
+struct timer{
+  uint8_t caps;                    // what the timer can do
+  uint8_t irq0;                    // CCR0 or Timer32 interrupt
+  uint8_t irqN;                    // CCR1-CCR6 and overflow interrupt, 0 if none
+};
+static const struct timer Timer[TIMERS_NUM] = {
+  {TIMERS_PERIODIC|TIMERS_CAPTURE|TIMERS_PWM,  8,  9}, // TA0
+  {TIMERS_PERIODIC|TIMERS_CAPTURE|TIMERS_PWM, 10, 11}, // TA1
+  {TIMERS_PERIODIC|TIMERS_CAPTURE|TIMERS_PWM, 12, 13}, // TA2
+  {TIMERS_PERIODIC|TIMERS_CAPTURE|TIMERS_PWM, 14, 15}, // TA3
+  {TIMERS_PERIODIC|TIMERS_ONESHOT, 25, 0},             // T32_1
+  {TIMERS_PERIODIC|TIMERS_ONESHOT, 26, 0}              // T32_2
+};
+// order TIMERS_ANY tries, pins are tied to the Timer_A modules
+static const uint8_t AnyOrder[TIMERS_NUM] = {
+  TIMERS_T32_1, TIMERS_T32_2, TIMERS_TA1, TIMERS_TA2, TIMERS_TA3, TIMERS_TA0
+};
+static Timer_A_Type *const TimerA[4] = {TIMER_A0, TIMER_A1, TIMER_A2, TIMER_A3};
+static Timer32_Type *const Timer32[2] = {TIMER32_1, TIMER32_2};
+
+static void nothing(void){};
+static void (*Task0[TIMERS_NUM])(void) = {nothing, nothing, nothing, nothing, nothing, nothing};
+static void (*TaskN[TIMERS_NUM])(void) = {nothing, nothing, nothing, nothing, nothing, nothing};
+static uint32_t Used;              // bit i set if instance i is allocated
+static uint32_t Periodic;          // bit i set if started by Timers_Periodic() or Timers_OneShot()
+
+//------------Timers_Request------------
+// Allocate a timer and its interrupt tasks.
+// Input: instance is the timer to use, or TIMERS_ANY for a free one
+//        caps is the capabilities needed
+//        task0 is called on the CCR0 or Timer32 interrupt, 0 if none
+//        taskN is called on the Timer_A CCR1-6 and overflow interrupt, 0 if none
+// Output: the timer allocated, -1 if none is free or able
+int Timers_Request(int instance, uint32_t caps, void(*task0)(void), void(*taskN)(void)){
+  int i, id = -1; long sr;
+  sr = StartCritical();
+  if(instance == TIMERS_ANY){
+    for(i=0; i<TIMERS_NUM; i++){
+      if(((Used&(1<<AnyOrder[i])) == 0) && ((Timer[AnyOrder[i]].caps&caps) == caps)){
+        id = AnyOrder[i];
+        break;
+      }
+    }
+  }else if((instance >= 0) && (instance < TIMERS_NUM) &&
+           ((Used&(1<<instance)) == 0) && ((Timer[instance].caps&caps) == caps)){
+    id = instance;
+  }
+  if((id >= 0) && (taskN != 0) && (Timer[id].irqN == 0)){
+    id = -1;                       // Timer32 has only one interrupt
+  }
+  if(id >= 0){
+    Used |= (1<<id);
+    Periodic &= ~(1<<id);
+    Task0[id] = task0 ? task0 : nothing;
+    TaskN[id] = taskN ? taskN : nothing;
+  }
+  EndCritical(sr);
+  return id;
+}
+
+//------------Timers_Stop------------
+// Halt a timer and disable its interrupts in the NVIC.
+// Input: id is the timer from Timers_Request()
+// Output: none
+void Timers_Stop(int id){
+  if((id < 0) || (id >= TIMERS_NUM)){
+    return;
+  }
+  if(id < TIMERS_T32_1){
+    TimerA[id]->CTL &= ~0x0030;    // halt Timer A
+    NVIC->ICER[0] = (1<<Timer[id].irq0)|(1<<Timer[id].irqN);
+  }else{
+    Timer32[id-TIMERS_T32_1]->CONTROL = 0;
+    Timer32[id-TIMERS_T32_1]->INTCLR = 0x00000001;
+    NVIC->ICER[0] = (1<<Timer[id].irq0);
+  }
+}
+
+//------------Timers_Release------------
+// Stop a timer and let it be allocated again.
+// Input: id is the timer from Timers_Request()
+// Output: none
+void Timers_Release(int id){long sr;
+  if((id < 0) || (id >= TIMERS_NUM)){
+    return;
+  }
+  Timers_Stop(id);
+  sr = StartCritical();
+  Task0[id] = nothing;
+  TaskN[id] = nothing;
+  Used &= ~(1<<id);
+  Periodic &= ~(1<<id);
+  EndCritical(sr);
+}
+
+//------------Timers_Periodic------------
+// Start periodic interrupts that call task0.  The interrupt
+// is acknowledged before task0 runs.
+// Input: id is the timer from Timers_Request()
+//        freq is interrupts per second, 1 Hz (3 Hz for Timer_A) to 200 kHz
+//        priority is 0 (high) to 7 (low)
+// Output: 0 if started, -1 if invalid input
+// Assumes: 48 MHz bus clock and 12 MHz SMCLK
+int Timers_Periodic(int id, uint32_t freq, uint8_t priority){
+  uint32_t irq, counts;
+  if((id < 0) || (id >= TIMERS_NUM) || ((Used&(1<<id)) == 0) ||
+     (freq == 0) || (freq > 200000) || (priority > 7) ||
+     ((id < TIMERS_T32_1) && (freq < 3))){
+    return -1;                     // invalid input
+  }
+  Timers_Stop(id);
+  Periodic |= (1<<id);
+  irq = Timer[id].irq0;
+  NVIC->IP[irq>>2] = (NVIC->IP[irq>>2]&~(0xFF<<(8*(irq&3))))|(priority<<(8*(irq&3)+5));
+  if(id < TIMERS_T32_1){
+    counts = 12000000/freq;
+    TimerA[id]->CTL = 0x0200;      // SMCLK, /1, stop mode, no interrupt
+    TimerA[id]->EX0 = 0x0000;      // input clock divider /1
+    if(counts > 65536){
+      counts = 187500/freq;
+      TimerA[id]->CTL = 0x02C0;    // SMCLK, /8, stop mode, no interrupt
+      TimerA[id]->EX0 = 0x0007;    // input clock divider /8
+    }
+    TimerA[id]->CCTL[0] = 0x0010;  // compare, interrupt on CCIFG
+    TimerA[id]->CCR[0] = counts - 1;
+    NVIC->ISER[0] = (1<<irq);
+    TimerA[id]->CTL |= 0x0014;     // reset and start in up mode
+  }else{
+    Timer32[id-TIMERS_T32_1]->LOAD = 48000000/freq - 1;
+    Timer32[id-TIMERS_T32_1]->INTCLR = 0x00000001;
+    Timer32[id-TIMERS_T32_1]->CONTROL = 0x000000E2; // periodic, interrupt, /1, 32-bit
+    NVIC->ISER[0] = (1<<irq);
+  }
+  return 0;
+}
+
+//------------Timers_OneShot------------
+// Call task0 once after a delay.  The interrupt is
+// acknowledged before task0 runs.
+// Input: id is the timer from Timers_Request(), a Timer32
+//        us is the delay, 1 us to 89 s (units of us)
+//        priority is 0 (high) to 7 (low)
+// Output: 0 if started, -1 if invalid input
+// Assumes: 48 MHz bus clock
+int Timers_OneShot(int id, uint32_t us, uint8_t priority){
+  uint32_t irq;
+  if((id < TIMERS_T32_1) || (id >= TIMERS_NUM) || ((Used&(1<<id)) == 0) ||
+     (us == 0) || (us > 89000000) || (priority > 7)){
+    return -1;                     // invalid input
+  }
+  Timers_Stop(id);
+  Periodic |= (1<<id);
+  irq = Timer[id].irq0;
+  NVIC->IP[irq>>2] = (NVIC->IP[irq>>2]&~(0xFF<<(8*(irq&3))))|(priority<<(8*(irq&3)+5));
+  Timer32[id-TIMERS_T32_1]->LOAD = 48*us - 1;
+  Timer32[id-TIMERS_T32_1]->INTCLR = 0x00000001;
+  Timer32[id-TIMERS_T32_1]->CONTROL = 0x000000A3; // one-shot, interrupt, /1, 32-bit
+  NVIC->ISER[0] = (1<<irq);
+  return 0;
+}
+
+//------------Timers_Used------------
+// Return the timers that are allocated.
+// Input: none
+// Output: bit i set if instance i is allocated
+uint32_t Timers_Used(void){
+  return Used;
+}
+
+void TA0_0_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_TA0)){
+    TIMER_A0->CCTL[0] &= ~0x0001;  // acknowledge capture/compare interrupt 0
+  }
+  (*Task0[TIMERS_TA0])();
+}
+void TA0_N_IRQHandler(void){
+  (*TaskN[TIMERS_TA0])();
+}
+void TA1_0_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_TA1)){
+    TIMER_A1->CCTL[0] &= ~0x0001;  // acknowledge capture/compare interrupt 0
+  }
+  (*Task0[TIMERS_TA1])();
+}
+void TA1_N_IRQHandler(void){
+  (*TaskN[TIMERS_TA1])();
+}
+void TA2_0_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_TA2)){
+    TIMER_A2->CCTL[0] &= ~0x0001;  // acknowledge capture/compare interrupt 0
+  }
+  (*Task0[TIMERS_TA2])();
+}
+void TA2_N_IRQHandler(void){
+  (*TaskN[TIMERS_TA2])();
+}
+void TA3_0_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_TA3)){
+    TIMER_A3->CCTL[0] &= ~0x0001;  // acknowledge capture/compare interrupt 0
+  }
+  (*Task0[TIMERS_TA3])();
+}
+void TA3_N_IRQHandler(void){
+  (*TaskN[TIMERS_TA3])();
+}
+void T32_INT1_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_T32_1)){
+    TIMER32_1->INTCLR = 0x00000001;  // acknowledge Timer32 Timer 1 interrupt
+  }
+  (*Task0[TIMERS_T32_1])();
+}
+void T32_INT2_IRQHandler(void){
+  if(Periodic&(1<<TIMERS_T32_2)){
+    TIMER32_2->INTCLR = 0x00000001;  // acknowledge Timer32 Timer 2 interrupt
+  }
+  (*Task0[TIMERS_T32_2])();
+}
@@ -0,0 +1,182 @@
+/**
+ * @file      Timers.h
+ * @brief     Allocate the hardware timers and dispatch their interrupts
+ * @details   The MSP432 has four Timer_A modules and two Timer32
+ * modules, and each interrupt vector can only have one handler.
+ * This module owns all ten timer interrupt handlers.  A driver
+ * asks for a timer with the capabilities it needs at init, and
+ * gets either the one it asked for or any free one, along with
+ * its interrupts dispatched through a table to the driver's
+ * functions.  A timer someone else holds is refused, instead of
+ * two drivers failing to link or one silently reprogramming the
+ * other's timer.<br>
+ * Drivers tied to pins ask for their instance: PWM on Timer A0,
+ * the IR trigger on Timer A1, the ultrasonic sensor on Timer A2,
+ * the tachometer on Timer A3, and the clock on Timer32 2.  Tools
+ * that only need a periodic interrupt, like TExaS, take any free
+ * one with TIMERS_ANY.
+ * @version   V1.0
+ * @author    Valvano
+ * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
+ * @warning   AS-IS
+ * @note      For more information see  http://users.ece.utexas.edu/~valvano/
+ * @date      October 18, 2026
+ ******************************************************************************/
+
+/* This example accompanies the books
+   "Embedded Systems: Introduction to the MSP432 Microcontroller",
+       ISBN: 978-1512185676, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Interfacing to the MSP432 Microcontroller",
+       ISBN: 978-1514676585, Jonathan Valvano, copyright (c) 2017
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex-M Microcontrollers",
+       ISBN: 978-1466468863, , Jonathan Valvano, copyright (c) 2017
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+
+Simplified BSD License (FreeBSD License)
+Copyright (c) 2017, Jonathan Valvano, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are
+those of the authors and should not be interpreted as representing official
+policies, either expressed or implied, of the FreeBSD Project.
+*/
+
+#ifndef TIMERS_H_
+#define TIMERS_H_
+
+/**
+ * \brief timer instances
+ */
+enum TimersInstance{
+  TIMERS_TA0,    /**< Timer A0, interrupts 8 and 9 */
+  TIMERS_TA1,    /**< Timer A1, interrupts 10 and 11 */
+  TIMERS_TA2,    /**< Timer A2, interrupts 12 and 13 */
+  TIMERS_TA3,    /**< Timer A3, interrupts 14 and 15 */
+  TIMERS_T32_1,  /**< Timer32 1, interrupt 25 */
+  TIMERS_T32_2,  /**< Timer32 2, interrupt 26 */
+  TIMERS_NUM     /**< number of timers */
+};
+
+/**
+ * \brief ask for any free timer with the capabilities
+ */
+#define TIMERS_ANY      (-1)
+
+/**
+ * \brief capability: interrupt at a fixed rate
+ */
+#define TIMERS_PERIODIC 0x01
+
+/**
+ * \brief capability: input capture on a pin
+ */
+#define TIMERS_CAPTURE  0x02
+
+/**
+ * \brief capability: PWM outputs on pins
+ */
+#define TIMERS_PWM      0x04
+
+/**
+ * \brief capability: one interrupt after a delay, Timers_OneShot()
+ */
+#define TIMERS_ONESHOT  0x08
+
+/**
+ * Allocate a timer.  task0 is called from the CCR0 interrupt
+ * of a Timer_A or the interrupt of a Timer32, and taskN from
+ * the CCR1-CCR6 and overflow interrupt of a Timer_A.  The tasks
+ * acknowledge their own interrupts, except those started with
+ * Timers_Periodic() or Timers_OneShot().  The driver still programs the timer and
+ * enables its interrupts in the NVIC.
+ *
+ * @param  instance is the timer to use, or TIMERS_ANY for a free one
+ * @param  caps is the capabilities needed, e.g., TIMERS_CAPTURE
+ * @param  task0 is a pointer to a user function, 0 if none
+ * @param  taskN is a pointer to a user function, 0 if none
+ * @return the timer allocated, -1 if none is free or has the capabilities
+ *
+ * @note   TIMERS_ANY picks the Timer32 modules first, since no pins are tied to them
+ * @brief  Allocate a timer
+ */
+int Timers_Request(int instance, uint32_t caps, void(*task0)(void), void(*taskN)(void));
+
+/**
+ * Free a timer: halt it, disable its interrupts in the NVIC,
+ * and let it be allocated again.
+ *
+ * @param  id is the timer from Timers_Request()
+ * @return none
+ * @brief  Free a timer
+ */
+void Timers_Release(int id);
+
+/**
+ * Start the periodic interrupts of a timer allocated with
+ * TIMERS_PERIODIC.  The interrupt is acknowledged before task0
+ * is called.  Timer32 modules count the 48 MHz bus clock, and
+ * Timer_A modules count the 12 MHz SMCLK, divided by 64 below
+ * 184 Hz.
+ *
+ * @param  id is the timer from Timers_Request()
+ * @param  freq is interrupts per second, 1 Hz (3 Hz for Timer_A) to 200 kHz
+ * @param  priority is 0 (high) to 7 (low)
+ * @return 0 if started, -1 if invalid input
+ * @brief  Start periodic interrupts
+ */
+int Timers_Periodic(int id, uint32_t freq, uint8_t priority);
+
+/**
+ * Call task0 once, a number of microseconds from now, on a
+ * timer allocated with TIMERS_ONESHOT.  The interrupt is
+ * acknowledged before task0 is called.  Calling it again
+ * before the interrupt restarts the delay.
+ *
+ * @param  id is the timer from Timers_Request()
+ * @param  us is the delay, 1 us to 89 s (units of us)
+ * @param  priority is 0 (high) to 7 (low)
+ * @return 0 if started, -1 if invalid input
+ * @note   Only the Timer32 modules can do this
+ * @brief  Start a one-shot interrupt
+ */
+int Timers_OneShot(int id, uint32_t us, uint8_t priority);
+
+/**
+ * Stop the interrupts of a timer without freeing it.
+ *
+ * @param  id is the timer from Timers_Request()
+ * @return none
+ * @brief  Stop a timer
+ */
+void Timers_Stop(int id);
+
+/**
+ * Return the timers that are allocated.
+ *
+ * @param  none
+ * @return bit i set if instance i is allocated
+ * @brief  Allocated timers
+ */
+uint32_t Timers_Used(void);
+
+#endif /* TIMERS_H_ */
@@ -49,15 +49,34 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 #include <stdint.h>
 #include <stdio.h>
+#include "../inc/BaudRate.h"
+#include "../inc/Format.h"
 #include "UART0.h"
 #include "msp.h"
 
 //------------UART0_Init------------
-// Initialize the UART for 115,200 baud rate (assuming 12 MHz SMCLK clock),
+// Initialize the UART for 115,200 baud rate,
 // 8 bit word length, no parity bits, one stop bit
 // Input: none
 // Output: none
 void UART0_Init(void){
+  UART0_InitBaud(115200);
+}
+
+//------------UART0_InitBaud------------
+// Initialize the UART for any baud rate, with the dividers
+// computed from the SMCLK frequency,
+// 8 bit word length, no parity bits, one stop bit
+// Input: baud  baud rate in bits/sec, up to SMCLK/3
+// Output: error of the actual baud rate in ppm, or
+//         BAUDRATE_BAD (port unchanged) if it cannot be generated
+int32_t UART0_InitBaud(uint32_t baud){
+  uint16_t brw, mctlw;
+  int32_t error;
+  error = BaudRate_Divider(BaudRate_SMCLK(), baud, &brw, &mctlw);
+  if(error == BAUDRATE_BAD){
+    return error;
+  }
   EUSCI_A0->CTLW0 = 0x0001;                   // hold the USCI module in reset mode
   // bit15=0,      no parity bits
   // bit14=x,      not used when parity is disabled
@@ -73,14 +92,15 @@ void UART0_Init(void){
   // bit1=0,       do not transmit break (not used here)
   // bit0=1,       hold logic in reset state while configuring
   EUSCI_A0->CTLW0 = 0x00C1;
-                                 // set the baud rate
-                                 // N = clock/baud rate = 12,000,000/115,200 = 104.1667
-  EUSCI_A0->BRW = 104;           // UCBR = baud rate = int(N) = 104
-  EUSCI_A0->MCTLW &= ~0xFFF1;    // clear first and second modulation stage bit fields
+                                 // set the baud rate, N = clock/baud rate
+                                 // e.g., 12,000,000/115,200 = 104.1667 gives
+  EUSCI_A0->BRW = brw;           // UCBR = int(N/16) = 6
+  EUSCI_A0->MCTLW = mctlw;       // UCBRS = 0x20 for frac(N), UCBRF = 8, UCOS16 = 1
   P1->SEL0 |= 0x0C;
   P1->SEL1 &= ~0x0C;             // configure P1.3 and P1.2 as primary module function
   EUSCI_A0->CTLW0 &= ~0x0001;    // enable the USCI module
   EUSCI_A0->IE &= ~0x000F;       // disable interrupts (transmit ready, start received, transmit empty, receive full)
+  return error;
 }
 
 //------------UART0_InChar------------
@@ -149,121 +169,59 @@ char character;
 // Input: 32-bit number to be transferred
 // Output: none
 // Variable format 1-10 digits with no space before or after
-void UART0_OutUDec(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    UART0_OutUDec(n/10);
-    n = n%10;
-  }
-  UART0_OutChar(n+'0'); /* n is between 0 and 9 */
+void UART0_OutUDec(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 0);
+  UART0_OutString(buf);
 }
-uint32_t Messageindexb;
-char Messageb[8];
-void static fillmessageb(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    fillmessageb(n/10);
-    n = n%10;
-  }
-  Messageb[Messageindexb] = (n+'0'); /* n is between 0 and 9 */
-  if(Messageindexb<7)Messageindexb++;
-}
-void static fillmessage4b(uint32_t n){
-  if(n>=1000){  // 1000 to 9999
-    Messageindexb = 0;
-  } else if(n>=100){  // 100 to 999
-    Messageb[0] = ' ';
-    Messageindexb = 1;
-  }else if(n>=10){ //
-    Messageb[0] = ' '; /* n is between 10 and 99 */
-    Messageb[1] = ' ';
-    Messageindexb = 2;
-  }else{
-    Messageb[0] = ' '; /* n is between 0 and 9 */
-    Messageb[1] = ' ';
-    Messageb[2] = ' ';
-    Messageindexb = 3;
-  }
-  fillmessageb(n);
-}
-void static fillmessage5b(uint32_t n){
-  if(n>99999)n=99999;
-  if(n>=10000){  // 10000 to 99999
-    Messageindexb = 0;
-  } else if(n>=1000){  // 1000 to 9999
-    Messageb[0] = ' ';
-    Messageindexb = 1;
-  }else if(n>=100){  // 100 to 999
-    Messageb[0] = ' ';
-    Messageb[1] = ' ';
-    Messageindexb = 2;
-  }else if(n>=10){ //
-    Messageb[0] = ' '; /* n is between 10 and 99 */
-    Messageb[1] = ' ';
-    Messageb[2] = ' ';
-    Messageindexb = 3;
-  }else{
-    Messageb[0] = ' '; /* n is between 0 and 9 */
-    Messageb[1] = ' ';
-    Messageb[2] = ' ';
-    Messageb[3] = ' ';
-    Messageindexb = 4;
-  }
-  fillmessageb(n);
+
+//-----------------------UART0_OutSDec-----------------------
+// Output a 32-bit number in signed decimal format
+// Input: 32-bit number to be transferred
+// Output: none
+// Variable format 1-11 characters with no space before or after
+void UART0_OutSDec(int32_t n){char buf[FORMAT_SIZE];
+  Format_SDec(buf, n, 0);
+  UART0_OutString(buf);
 }
+
 //-----------------------UART0_OutUDec4-----------------------
 // Output a 32-bit number in unsigned decimal format
 // Input: 32-bit number to be transferred
 // Output: none
 // Fixed format 4 digits with no space before or after
-void UART0_OutUDec4(uint32_t n){
-  if(n>9999){
-    UART0_OutString("****");
-  }else{
-    Messageindexb = 0;
-    fillmessage4b(n);
-    Messageb[Messageindexb] = 0; // terminate
-    UART0_OutString(Messageb);
-  }
+void UART0_OutUDec4(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 4);          // "****" if more than 4 digits
+  UART0_OutString(buf);
 }
+
 //-----------------------UART0_OutUDec5-----------------------
 // Output a 32-bit number in unsigned decimal format
 // Input: 32-bit number to be transferred
 // Output: none
 // Fixed format 5 digits with no space before or after
-void UART0_OutUDec5(uint32_t n){
-  if(n>99999){
-    UART0_OutString("*****");
-  }else{
-    Messageindexb = 0;
-    fillmessage5b(n);
-    Messageb[Messageindexb] = 0; // terminate
-    UART0_OutString(Messageb);
-  }
+void UART0_OutUDec5(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UDec(buf, n, 5);          // "*****" if more than 5 digits
+  UART0_OutString(buf);
 }
+
 //-----------------------UART0_OutUFix1-----------------------
 // Output a 32-bit number in unsigned decimal format
 // Input: 32-bit number to be transferred
 // Output: none
 // fixed format <digit>.<digit> with no space before or after
-void UART0_OutUFix1(uint32_t n){
-  UART0_OutUDec(n/10);
-  UART0_OutChar('.');
-  UART0_OutUDec(n%10);
+void UART0_OutUFix1(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UFix(buf, n, 1, 0);
+  UART0_OutString(buf);
 }
+
 //-----------------------UART0_OutUFix2-----------------------
 // Output a 32-bit number in unsigned decimal format
 // Input: 32-bit number to be transferred
 // Output: none
 // fixed format <digit>.<digit><digit> with no space before or after
-void UART0_OutUFix2(uint32_t n){
-  UART0_OutUDec(n/100);
-  UART0_OutChar('.');
-  n = n%100;
-  UART0_OutUDec(n/10);
-  UART0_OutUDec(n%10);
+void UART0_OutUFix2(uint32_t n){char buf[FORMAT_SIZE];
+  Format_UFix(buf, n, 2, 0);
+  UART0_OutString(buf);
 }
 //---------------------UART0_InUHex----------------------------------------
 // Accepts ASCII input in unsigned hexadecimal (base 16) format
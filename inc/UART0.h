@@ -87,15 +87,28 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 /**
  * @details   Initialize EUSCI_A0 for UART operation
- * @details   115,200 baud rate (assuming 12 MHz SMCLK clock),
+ * @details   115,200 baud rate,
  * @details   8 bit word length, no parity bits, one stop bit
  * @param  none
  * @return none
- * @note   assumes 48 MHz bus and 12 MHz SMCLK
+ * @see UART0_InitBaud()
  * @brief  Initialize EUSCI A0
  */
 void UART0_Init(void);
 
+/**
+ * @details   Initialize EUSCI_A0 for UART operation at any baud rate
+ * @details   The dividers and modulation pattern are computed from
+ * @details   the SMCLK frequency, 8 bit word length, no parity bits, one stop bit
+ * @param  baud is the baud rate in bits/sec, up to SMCLK/3
+ * @return error of the actual baud rate in parts per million,
+ * or BAUDRATE_BAD if it cannot be generated and the port is unchanged
+ * @note   with the 12 MHz SMCLK from Clock_Init48MHz(), 1, 1.5, 2 and
+ * 3 Mbaud have no error
+ * @brief  Initialize EUSCI A0 at a baud rate
+ */
+int32_t UART0_InitBaud(uint32_t baud);
+
 
 /**
  * @details   Initializes C standard library, enables printf to work
@@ -168,6 +181,16 @@ uint32_t UART0_InUDec(void);
  */
 void UART0_OutUDec(uint32_t n);
 
+/**
+ * @details   Transmit a number as ASCII characters in signed decimal format
+ * @details   Variable format 1-11 characters with no space before or after
+ * @param  n is a signed 32-bit number to be transferred
+ * @return none
+ * @note   UART0_Init must be called once prior
+ * @brief  Transmit a signed number out of MSP432
+ */
+void UART0_OutSDec(int32_t n);
+
 
 /**
  * @details   Receive an unsigned number from EUSCI_A0 UART
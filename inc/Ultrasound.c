@@ -1,9 +1,8 @@
 // Ultrasound.c
 // Runs on MSP432
-// Provide mid-level functions that initialize ports, start
-// an ultrasonic sensor measurement, and finish an ultrasonic
-// sensor measurement using the HC-SR04 ultrasonic distance
-// sensor.
+// Provide mid-level functions that initialize ports and
+// take ultrasonic sensor measurements continuously in the
+// background using the HC-SR04 ultrasonic distance sensor.
 // Daniel Valvano
 // May 2, 2017
 
@@ -47,95 +46,218 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 // Pololu #3543 Vreg (5V regulator output) connected to HC-SR04 Vcc (+5V) and MSP432 +5V (J3.21)
 // 22k top connected to HC-SR04 Echo (digital output from sensor)
-// 22k bottom connected to 33k top and MSP432 P6.6 (J4.36) (digital input to MSP432)
+// 22k bottom connected to 33k top and MSP432 P5.6 (J4.37) (digital input to MSP432)
 // 33k bottom connected to ground
 // Pololu ground connected to HC-SR04 ground and MSP432 ground (J3.22)
-// MSP432 P5.6 (J4.37) (digital output from MSP432) connected to HC-SR04 trigger
+// MSP432 P6.6 (J4.36) (digital output from MSP432) connected to HC-SR04 trigger
+
+// Timer A2 runs continuously at 12 MHz and is used for everything:
+//   CCR1 captures both edges of the echo on P5.6 (TA2CCP1)
+//   CCR3 ends the 10 us trigger pulse on P6.6 (TA2.3) in hardware
+//   overflow (every 5.461 ms) counts the upper 16 bits of time and
+//   starts a new measurement every ULTRASOUND_PERIOD overflows
+// A measurement not finished when the next one starts has timed out.
 
 #include <stdint.h>
-#include "../inc/Clock.h"
-#include "../inc/TA2InputCapture.h"
+#include "../inc/CortexM.h"
+#include "../inc/Convert.h"
+#include "../inc/Timers.h"
+#include "../inc/Ultrasound.h"
 #include "msp.h"
 
-uint16_t Ultrasound_FirstTime, Ultrasound_SecondTime;
-int Ultrasound_Count = 0;          // incremented with every interrupt
-int Ultrasound_Valid = 0;          // measurement valid if non-zero
-int Ultrasound_Busy = 0;           // measurement in progress if non-zero
-
-void ultrasoundint(uint16_t currenttime){
-  if((Ultrasound_Count%2) == 0){
-    // this is the first edge in the measurement
-    Ultrasound_FirstTime = currenttime;
-    Ultrasound_Valid = 0;
-  }else{
-    // this is the second edge in the measurement
-    Ultrasound_SecondTime = currenttime;
-    Ultrasound_Valid = 1;
-    Ultrasound_Busy = 0;
-  }
-  Ultrasound_Count = Ultrasound_Count + 1;
-}
+#define TRIGGERCOUNTS 120          // 10 us trigger pulse (units of 83.33 ns)
+#define MAXCOUNTS 280000           // 4 m, longer echoes mean no object (units of 83.33 ns)
+
+volatile uint32_t Ultrasound_Overflows;  // upper 16 bits of 32-bit time
+uint32_t Ultrasound_StartTime;     // 32-bit time of the echo rising edge
+volatile uint32_t Ultrasound_Time; // 32-bit time of the latest valid echo falling edge
+volatile uint16_t Ultrasound_Mm;   // latest valid distance (units mm)
+volatile uint16_t Ultrasound_In;   // latest valid distance (units 10*in)
+volatile uint32_t Ultrasound_Count;// number of valid measurements
+volatile uint32_t Ultrasound_Missed;   // number of measurements with no valid echo
+uint32_t Ultrasound_LastCount;     // value of Ultrasound_Count at last Ultrasound_End
+int Ultrasound_State;              // 0 idle, 1 waiting for echo rise, 2 waiting for echo fall
+int Ultrasound_Period;             // overflows until the next trigger
+static int Timer = -1;             // Timer A2 from Timers_Request()
+static void ultrasound(void);
 
 // ------------Ultrasound_Init------------
-// Initialize a GPIO pin for output, which will be
-// used to trigger the ultrasonic sensor.
-// Initialize the input capture interface, which
-// will be used to take the measurement.
+// Initialize P6.6 as the Timer A2 trigger output and P5.6
+// as the Timer A2 echo capture input.  Start taking
+// measurements every ULTRASOUND_PERIOD*5.461 ms in the
+// background.
 // Input: none
 // Output: none
-void Ultrasound_Init(void){
-  // initialize P6.6 and make it GPIO
-  P6->SEL0 &= ~0x40;
-  P6->SEL1 &= ~0x40;               // configure P6.6 as GPIO
+// Assumes: 12 MHz SMCLK
+// Note: uses all of Timer A2, so it does nothing if
+//       TimerA2_Init(), TimerA2Capture_Init() or another
+//       driver holds it
+void Ultrasound_Init(void){long sr;
+  sr = StartCritical();
+  if(Timer < 0){
+    Timer = Timers_Request(TIMERS_TA2, TIMERS_CAPTURE|TIMERS_PWM, 0, &ultrasound);
+    if(Timer < 0){
+      EndCritical(sr);
+      return;                      // Timer A2 is in use
+    }
+  }
+  Ultrasound_Overflows = 0;
+  Ultrasound_Count = Ultrasound_LastCount = 0;
+  Ultrasound_Missed = 0;
+  Ultrasound_State = 0;
+  Ultrasound_Period = 1;           // first measurement after the first overflow
+  // initialize P6.6 and make it TA2.3 output
+  P6->SEL0 |= 0x40;
+  P6->SEL1 &= ~0x40;               // configure P6.6 as TA2.3
   P6->DIR |= 0x40;                 // make P6.6 out
-  P6->OUT &= ~0x40;
-  TimerA2Capture_Init(&ultrasoundint);
+  // initialize P5.6 and make it TA2CCP1 input
+  P5->SEL0 |= 0x40;
+  P5->SEL1 &= ~0x40;               // configure P5.6 as TA2CCP1
+  P5->DIR &= ~0x40;                // make P5.6 in
+  TIMER_A2->CTL &= ~0x0030;        // halt Timer A2
+  TIMER_A2->CTL = 0x0200;          // SMCLK, /1, stop mode, no interrupt
+  TIMER_A2->EX0 &= ~0x0007;        // configure for input clock divider /1
+  // bits15-14=11,     capture on both edges
+  // bits13-12=00,     capture/compare input on CCI1A
+  // bit11=1,          synchronous capture source
+  // bit8=1,           capture mode
+  // bit4=1,           enable capture/compare interrupt
+  // bit0=0,           clear capture/compare interrupt pending
+  TIMER_A2->CCTL[1] = 0xC910;
+  // bits7-5=000,      output mode 0, output the OUT bit
+  // bit4=0,           no interrupt, compare only ends the pulse
+  // bit2=0,           trigger low
+  TIMER_A2->CCTL[3] = 0x0000;
+  NVIC->IP[3] = (NVIC->IP[3]&0xFFFF00FF)|0x00004000; // priority 2
+// interrupts enabled in the main program after all devices initialized
+  NVIC->ISER[0] = 0x00002000;      // enable interrupt 13 in NVIC
+  // bits5-4=10,       continuous count up mode
+  // bit2=1,           set this bit to clear
+  // bit1=1,           interrupt on rollover
+  // bit0=0,           clear interrupt pending
+  TIMER_A2->CTL |= 0x0026;         // reset and start Timer A2 in continuous up mode
+  EndCritical(sr);
+}
+
+static void ultrasound(void){uint16_t ccr; uint32_t time;
+  if(TIMER_A2->CTL&0x0001){        // overflow
+    TIMER_A2->CTL &= ~0x0001;      // acknowledge overflow
+    Ultrasound_Overflows = Ultrasound_Overflows + 0x00010000;
+    Ultrasound_Period = Ultrasound_Period - 1;
+    if(Ultrasound_Period <= 0){
+      Ultrasound_Period = ULTRASOUND_PERIOD;
+      if(Ultrasound_State){
+        Ultrasound_Missed = Ultrasound_Missed + 1; // echo missed or never ended
+      }
+      Ultrasound_State = 1;
+      TIMER_A2->CCTL[3] = 0x0004;  // output mode 0, trigger high now
+      TIMER_A2->CCR[3] = TIMER_A2->R + TRIGGERCOUNTS;
+      TIMER_A2->CCTL[3] = 0x00A0;  // output mode 5, trigger low at CCR3
+    }
+  }
+  if(TIMER_A2->CCTL[1]&0x0001){    // echo edge
+    TIMER_A2->CCTL[1] &= ~0x0001;  // acknowledge capture/compare interrupt 1
+    ccr = TIMER_A2->CCR[1];
+    time = Ultrasound_Overflows|ccr;
+    if(ccr&0x8000){
+      if(TIMER_A2->CTL&0x0001){
+        // overflow pending, but the capture was before it
+      }else if((uint16_t)TIMER_A2->R < 0x8000){
+        // overflow counted above, but the capture was before it
+        time = time - 0x00010000;
+      }
+    }else if(TIMER_A2->CTL&0x0001){
+      time = time + 0x00010000;    // overflow pending, and the capture was after it
+    }
+    if(TIMER_A2->CCTL[1]&0x0008){  // input high, so this was the rising edge
+      if(Ultrasound_State == 1){
+        Ultrasound_StartTime = time;
+        Ultrasound_State = 2;
+      }
+    }else if(Ultrasound_State == 2){
+      time = time - Ultrasound_StartTime;
+      if(time < MAXCOUNTS){
+        Ultrasound_Mm = Convert_EchoToMm(time);
+        Ultrasound_In = Convert_EchoToIn(time);
+        Ultrasound_Time = Ultrasound_StartTime + time;
+        Ultrasound_Count = Ultrasound_Count + 1;
+      }else{
+        Ultrasound_Missed = Ultrasound_Missed + 1; // no object in range
+      }
+      Ultrasound_State = 0;
+    }
+  }
 }
 
-// ------------Ultrasound_Start------------
-// Start a measurement using the ultrasonic sensor.
-// If a measurement is currently in progress, return
-// immediately.
+// ------------Ultrasound_Now------------
+// Return the 32-bit Timer A2 time.
 // Input: none
-// Output: none
+// Output: time (units of 83.33 ns)
 // Assumes: Ultrasound_Init() has been called
-// Assumes: Clock_Init48MHz() has been called
-void Ultrasound_Start(void){
-  if(Ultrasound_Busy == 0){
-    // no measurement is in progress, so start one
-    Ultrasound_Busy = 1;
-    P6->OUT |= 0x40;
-    Clock_Delay1us(10);
-    P6->OUT &= ~0x40;
+uint32_t Ultrasound_Now(void){uint32_t ovf; uint16_t r;
+  do{
+    ovf = Ultrasound_Overflows;
+    r = TIMER_A2->R;
+  }while(ovf != Ultrasound_Overflows);
+  if((TIMER_A2->CTL&0x0001) && (r < 0x8000)){
+    ovf = ovf + 0x00010000;        // overflow not yet counted by the ISR
   }
+  return ovf|r;
+}
+
+// ------------Ultrasound_Latest------------
+// Return the most recent valid distance measured in the
+// background, and how long ago it was measured.
+// Input: distMm is pointer to store measured distance (units mm)
+//        age is pointer to store time since the measurement (units ms)
+// Output: one if a valid measurement has been made
+//         zero if none yet and pointers unchanged
+// Assumes: Ultrasound_Init() has been called
+int Ultrasound_Latest(uint16_t *distMm, uint32_t *age){long sr; uint32_t time;
+  sr = StartCritical();
+  if(Ultrasound_Count == 0){
+    EndCritical(sr);
+    return 0;
+  }
+  *distMm = Ultrasound_Mm;
+  time = Ultrasound_Time;
+  EndCritical(sr);
+  *age = (Ultrasound_Now() - time)/12000;
+  return 1;
 }
 
 // ------------Ultrasound_End------------
 // Query the HC-SR04 ultrasonic distance sensor for a
-// measurement.  If no measurement is currently in
-// progress, start one and return zero immediately.
-// If the measurement is not yet complete, return
-// zero immediately.  If the measurement is complete,
-// store the result in the pointers provided and
-// return one.
+// new measurement.  Measurements are started every
+// ULTRASOUND_PERIOD*5.461 ms in the background.  If
+// a valid measurement has finished since the last call,
+// store the result in the pointers provided and return
+// one.  Otherwise return zero immediately.
 // Input: distMm is pointer to store measured distance (units mm)
 //        distIn is pointer to store measured distance (units 10*in)
 // Output: one if measurement is ready and pointers are valid
 //         zero if measurement is not ready and pointers unchanged
 // Assumes: Ultrasound_Init() has been called
-// Assumes: Clock_Init48MHz() has been called
-int Ultrasound_End(uint16_t *distMm, uint16_t *distIn){
-  if((Ultrasound_Busy == 0) && (Ultrasound_Valid == 0)){
-    // no measurement is in progress, and no measurement is finished, so start one
-    Ultrasound_Start();
+int Ultrasound_End(uint16_t *distMm, uint16_t *distIn){long sr;
+  sr = StartCritical();
+  if(Ultrasound_Count == Ultrasound_LastCount){
+    EndCritical(sr);
     return 0;
   }
-  if((Ultrasound_Busy != 0) && (Ultrasound_Valid == 0)){
-    // measurement is in progress, but it is not finished
-    return 0;
-  }
-  // measurement is ready
-  *distMm = ((uint16_t)(Ultrasound_SecondTime - Ultrasound_FirstTime))/70;
-  *distIn = ((uint16_t)(Ultrasound_SecondTime - Ultrasound_FirstTime))/178;
+  Ultrasound_LastCount = Ultrasound_Count;
+  *distMm = Ultrasound_Mm;
+  *distIn = Ultrasound_In;
+  EndCritical(sr);
   return 1;
 }
+
+// ------------Ultrasound_Timeouts------------
+// Return the number of measurements that ended without a
+// valid echo, because the echo was missed, never ended, or
+// was longer than 4 m.
+// Input: none
+// Output: number of failed measurements since Ultrasound_Init()
+// Assumes: Ultrasound_Init() has been called
+uint32_t Ultrasound_Timeouts(void){
+  return Ultrasound_Missed;
+}
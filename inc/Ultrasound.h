@@ -1,10 +1,9 @@
 /**
  * @file      Ultrasound.h
  * @brief     Take ultrasonic distance measurements
- * @details   Provide mid-level functions that initialize ports, start
- * an ultrasonic sensor measurement, and finish an ultrasonic
- * sensor measurement using the HC-SR04 ultrasonic distance
- * sensor.
+ * @details   Provide mid-level functions that initialize ports and
+ * take ultrasonic sensor measurements continuously in the
+ * background using the HC-SR04 ultrasonic distance sensor.
  * @version   V1.0
  * @author    Valvano
  * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
@@ -54,55 +53,83 @@ policies, either expressed or implied, of the FreeBSD Project.
 
 // Pololu #3543 Vreg (5V regulator output) connected to HC-SR04 Vcc (+5V) and MSP432 +5V (J3.21)
 // 22k top connected to HC-SR04 Echo (digital output from sensor)
-// 22k bottom connected to 33k top and MSP432 P6.6 (J4.36) (digital input to MSP432)
+// 22k bottom connected to 33k top and MSP432 P5.6 (J4.37) (digital input to MSP432)
 // 33k bottom connected to ground
 // Pololu ground connected to HC-SR04 ground and MSP432 ground (J3.22)
-// MSP432 P5.6 (J4.37) (digital output from MSP432) connected to HC-SR04 trigger
+// MSP432 P6.6 (J4.36) (digital output from MSP432) connected to HC-SR04 trigger
 
 
 #ifndef ULTRASOUND_H_
 #define ULTRASOUND_H_
 
+/**
+ * \brief Time between measurements, in units of Timer A2 overflows (5.461 ms)
+ */
+#define ULTRASOUND_PERIOD 11
 
 /**
- * Initialize a GPIO pin for output, which will be
- * used to trigger the ultrasonic sensor.
- * Initialize the input capture interface, which
- * will be used to take the measurement.
+ * Initialize P6.6 as the Timer A2 trigger output and P5.6
+ * as the Timer A2 echo capture input.  Start taking
+ * measurements every ULTRASOUND_PERIOD*5.461 ms (60 ms)
+ * in the background.  The 10 us trigger pulse is ended
+ * by the timer, both echo edges are captured with 32-bit
+ * time, and a measurement with no echo times out when
+ * the next one starts.
  * @param none
  * @return none
+ * @note  Assumes low-speed subsystem master clock is 12 MHz
+ * @note  Uses all of Timer A2, so it does nothing if TimerA2_Init(), TimerA2Capture_Init() or another driver holds it, see Timers.h
+ * @note  Interrupts must be enabled in the main program.
  * @brief  Initialize ultrasonic sensor interface
  */
 void Ultrasound_Init(void);
 
 /**
- * Start a measurement using the ultrasonic sensor.
- * If a measurement is currently in progress, return
- * immediately.
+ * Return the 32-bit time kept by Timer A2 and its overflow
+ * interrupt.  It wraps every 358 seconds.
  * @param none
- * @return none
- * @note Assumes Ultrasound_Init() has been called<br>
- * @note Assumes Clock_Init48MHz() has been called
- * @brief  Start an ultrasonic distance measurement
+ * @return time (units of 83.33 ns)
+ * @note Assumes Ultrasound_Init() has been called
+ * @brief  Read 32-bit ultrasound time
  */
-void Ultrasound_Start(void);
+uint32_t Ultrasound_Now(void);
+
+/**
+ * Return the most recent valid distance measured in the
+ * background, and how long ago it was measured.
+ * @param distMm is pointer to store measured distance (units mm)
+ * @param age is pointer to store time since the measurement (units ms)
+ * @return one if a valid measurement has been made<br>
+ *         zero if none yet and pointers unchanged
+ * @note Assumes Ultrasound_Init() has been called
+ * @brief  Read the latest ultrasonic distance
+ */
+int Ultrasound_Latest(uint16_t *distMm, uint32_t *age);
 
 /**
  * Query the HC-SR04 ultrasonic distance sensor for a
- * measurement.  If no measurement is currently in
- * progress, start one and return zero immediately.
- * If the measurement is not yet complete, return
- * zero immediately.  If the measurement is complete,
- * store the result in the pointers provided and
- * return one.
+ * new measurement.  If a valid measurement has finished
+ * since the last call, store the result in the pointers
+ * provided and return one.  Otherwise return zero
+ * immediately.
  * @param distMm is pointer to store measured distance (units mm)
  * @param distIn is pointer to store measured distance (units 10*in)
  * @return one if measurement is ready and pointers are valid<br>
  *         zero if measurement is not ready and pointers unchanged
- * @note Assumes Ultrasound_Init() has been called<br>
- * @note Assumes Clock_Init48MHz() has been called
- * @brief  End or resume an ultrasonic distance measurement
+ * @note Assumes Ultrasound_Init() has been called
+ * @brief  Get a new ultrasonic distance measurement
  */
 int Ultrasound_End(uint16_t *distMm, uint16_t *distIn);
 
+/**
+ * Return the number of measurements that ended without a
+ * valid echo, because the echo was missed, never ended, or
+ * was longer than 4 m.
+ * @param none
+ * @return number of failed measurements since Ultrasound_Init()
+ * @note Assumes Ultrasound_Init() has been called
+ * @brief  Count ultrasonic timeouts
+ */
+uint32_t Ultrasound_Timeouts(void);
+
 #endif /* ULTRASOUND_H_ */